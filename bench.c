@@ -0,0 +1,604 @@
+/// Benchmark suite of the dancing links library.
+///
+/// Runs reproducible exact cover workloads (hard sudokus, N-queens with slack subsets, polyomino packings,
+/// random sparse matrices and large construction-only loads), each one in its own process,
+/// and reports one line per workload in JSON format on standard output:
+/// number of solutions and nodes, build and search times, nodes and link updates per second, and peak resident set size.
+///
+/// Usage: dancing_links_bench [baseline [workload...]]
+///
+/// If workloads are named, only those are run (the baseline can then be "-" for none.)
+///
+/// If a baseline (a previous output of the benchmark, with or without times) is given, numbers of solutions and nodes must be identical to it.
+/// Times depend on the machine: they are only compared with the ones of a previous output of the benchmark on the same machine,
+/// named by the environment variable \p DLX_BENCH_TIMES, and must not exceed them by more than a tolerance
+/// (25 % by default, or the value of the environment variable \p DLX_BENCH_TOLERANCE.)
+/// The exit status is 1 if a mismatch or a regression is found.
+///
+/// Searches are run by the dancing links search engine, or by the dancing cells one if the environment variable
+/// \p DLX_BENCH_ENGINE is set to "cells" (both engines visit the same number of nodes), or by the engine selected
+/// automatically if it is set to "auto" (numbers of nodes then differ from the baseline if propagation is selected.)
+///
+/// The links of searches are allocated with the memory policies listed in the environment variable \p DLX_BENCH_MEMORY, if set
+/// (among "huge", "explicit", "interleave" and "local", see dlx_memory_policy_set()): the bytes of links backed by huge pages
+/// and the page faults during searches are reported.
+
+#include "dancing_links.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/// Times below this threshold (in seconds) are too short to be compared with a baseline.
+#define BENCH_MIN_SECONDS 0.05
+
+struct bench_result
+{
+  unsigned long solutions;
+  unsigned long nodes;
+  unsigned long updates;
+  double build_seconds;
+  double search_seconds;
+  long peak_rss_kb;
+  unsigned long huge_page_kb;
+  unsigned long search_faults;
+};
+
+struct bench_workload
+{
+  const char *name;
+  void (*run) (struct bench_result *result, const void *parameters);
+  const void *parameters;
+};
+
+static double
+bench_now (void)
+{
+  struct timespec now;
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/// Pseudo-random generator (xorshift64), so that random workloads are reproducible.
+static unsigned long long
+bench_random (unsigned long long *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static void
+bench_solution_ignore (Universe universe, unsigned long length, const char *const *solution, void *data)
+{
+  (void) universe;
+  (void) length;
+  (void) solution;
+  (void) data;
+}
+
+/// Searches all the solutions of a universe and accumulates the statistics of the search.
+static void
+bench_search (Universe universe, struct bench_result *result)
+{
+  const char *memory = getenv ("DLX_BENCH_MEMORY");
+
+  if (memory)
+    dlx_memory_policy_set (universe, (strstr (memory, "huge") ? DLX_MEMORY_HUGE_PAGES : 0) | (strstr (memory, "explicit") ? DLX_MEMORY_EXPLICIT_HUGE_PAGES : 0)
+                           | (strstr (memory, "interleave") ? DLX_MEMORY_INTERLEAVE : 0) | (strstr (memory, "local") ? DLX_MEMORY_LOCAL : 0));
+
+  SearchContext context = dlx_search_context_create (universe);
+  const char *engine = getenv ("DLX_BENCH_ENGINE");
+
+  dlx_displayer_set (context, bench_solution_ignore, 0);
+  if (engine && !strcmp (engine, "cells"))
+    dlx_engine_set (context, DLX_ENGINE_CELLS);
+  else if (engine && !strcmp (engine, "auto"))
+    dlx_engine_set (context, DLX_ENGINE_AUTO);
+
+  double start = bench_now ();
+
+  result->solutions += dlx_exact_cover_search (context, 0);
+  result->search_seconds += bench_now () - start;
+  result->nodes += dlx_search_nodes (context);
+  result->updates += dlx_search_updates (context);
+  const struct dlx_memory_statistics *statistics = dlx_memory_statistics (context);
+
+  result->huge_page_kb += statistics->huge_page_bytes / 1024;
+  result->search_faults += statistics->search_faults;
+  dlx_search_context_destroy (context);
+}
+
+/// Hard sudoku grids (81 cells, row by row, '.' for empty cells.)
+static const char *const bench_sudoku_grids[] = {
+  "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+  "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+  "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+  "48.3............71.2.......7.5....6....2..8.............1.76...3.....4......5....",
+  "....14....3....2...7..........9...3.6.1.............8.2.....1.4....5.6.....7.8...",
+  "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+  "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",
+  "1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6...3...9.8...2.....1",
+  0
+};
+
+/// Solves hard sudoku grids, each one on a clone of a base universe of the 729 candidates.
+static void
+bench_sudoku (struct bench_result *result, const void *parameters)
+{
+  (void) parameters;
+  double start = bench_now ();
+  Universe sudoku = dlx_universe_create ();
+  char name[16], cell[8], row[8], column[8], box[8];
+  const char *elements[] = { cell, row, column, box };
+
+  for (int r = 1; r <= 9; r++)
+    for (int c = 1; c <= 9; c++)
+      for (int n = 1; n <= 9; n++)
+      {
+        snprintf (name, sizeof (name), "R%iC%i#%i", r, c, n);
+        snprintf (cell, sizeof (cell), "R%iC%i", r, c);
+        snprintf (row, sizeof (row), "R%i#%i", r, n);
+        snprintf (column, sizeof (column), "C%i#%i", c, n);
+        snprintf (box, sizeof (box), "B%i#%i", 3 * ((r - 1) / 3) + (c - 1) / 3 + 1, n);
+        dlx_subset_define (sudoku, name, sizeof (elements) / sizeof (*elements), elements);
+      }
+  dlx_trace_set (sudoku, 0);
+  result->build_seconds += bench_now () - start;
+
+  for (const char *const *grid = bench_sudoku_grids; *grid; grid++)
+  {
+    start = bench_now ();
+    Universe puzzle = dlx_universe_clone (sudoku);
+
+    for (int i = 0; i < 81; i++)
+      if ((*grid)[i] != '.')
+      {
+        snprintf (name, sizeof (name), "R%iC%i#%c", i / 9 + 1, i % 9 + 1, (*grid)[i]);
+        dlx_subset_require_in_solution (puzzle, name);
+      }
+    result->build_seconds += bench_now () - start;
+
+    bench_search (puzzle, result);
+    dlx_universe_destroy (puzzle);
+  }
+
+  dlx_universe_destroy (sudoku);
+}
+
+/// Places N queens on a N×N board.
+///
+/// Diagonals are not necessarily occupied by a queen: each diagonal can be covered by a slack subset instead
+/// (which plays the role of a secondary column), so that the number of solutions is the number of placements of the queens.
+static void
+bench_queens (struct bench_result *result, const void *parameters)
+{
+  int n = *(const int *) parameters;
+  double start = bench_now ();
+  Universe queens = dlx_universe_create ();
+  char name[32], row[16], column[16], diagonal[16], antidiagonal[16];
+  const char *elements[] = { row, column, diagonal, antidiagonal };
+
+  dlx_trace_set (queens, 0);
+  for (int r = 0; r < n; r++)
+    for (int c = 0; c < n; c++)
+    {
+      snprintf (name, sizeof (name), "Q%i,%i", r, c);
+      snprintf (row, sizeof (row), "R%i", r);
+      snprintf (column, sizeof (column), "C%i", c);
+      snprintf (diagonal, sizeof (diagonal), "A%i", r + c);
+      snprintf (antidiagonal, sizeof (antidiagonal), "B%i", r - c + n - 1);
+      dlx_subset_define (queens, name, sizeof (elements) / sizeof (*elements), elements);
+    }
+  for (int d = 0; d < 2 * n - 1; d++)
+  {
+    snprintf (name, sizeof (name), "SA%i", d);
+    snprintf (diagonal, sizeof (diagonal), "A%i", d);
+    dlx_subset_define (queens, name, 1, elements + 2);
+    snprintf (name, sizeof (name), "SB%i", d);
+    snprintf (antidiagonal, sizeof (antidiagonal), "B%i", d);
+    dlx_subset_define (queens, name, 1, elements + 3);
+  }
+  result->build_seconds += bench_now () - start;
+
+  bench_search (queens, result);
+  dlx_universe_destroy (queens);
+}
+
+/// A polyomino packing: pieces (as rows of '#' separated by '/') to be placed on a rectangular board.
+struct bench_packing
+{
+  int width;
+  int height;
+  const char *holes;             ///< Cells of the board not to be covered ('#' in a row-by-row picture of the board), or 0.
+  int reflections;               ///< If set, pieces can be turned over.
+  const char *const *pieces;     ///< Pictures of the pieces, terminated by 0.
+};
+
+static const char *const bench_pentominoes[] = {
+  "F.##/##./.#.", "I#####", "L####/#...", "N##../.###", "P###/##.", "T###/.#./.#.",
+  "U#.#/###", "V#../#../###", "W#../##./.##", "X.#./###/.#.", "Y####/.#..", "Z##./.#./.##", 0
+};
+
+static const char *const bench_tetrominoes[] = {
+  "I####", "O##/##", "T###/.#.", "S.##/##.", "Z##./.##", "J###/..#", "L###/#..", 0
+};
+
+/// Packs polyominoes on a board. Every piece is used once.
+/// The first character of a piece is its name, followed by its picture.
+static void
+bench_packing (struct bench_result *result, const void *parameters)
+{
+  const struct bench_packing *packing = parameters;
+  double start = bench_now ();
+  Universe universe = dlx_universe_create ();
+  char name[2];
+  char cells[8][24];
+  const char *elements[9];
+
+  dlx_trace_set (universe, 0);
+  for (const char *const *piece = packing->pieces; *piece; piece++)
+  {
+    // Cells of the piece.
+    int x[8], y[8], size = 0;
+
+    for (int i = 1, r = 0, c = 0; (*piece)[i]; i++)
+      if ((*piece)[i] == '/')
+        r++, c = 0;
+      else
+      {
+        if ((*piece)[i] == '#')
+          x[size] = r, y[size] = c, size++;
+        c++;
+      }
+
+    snprintf (name, sizeof (name), "%c", **piece);
+    elements[0] = name;
+
+    // Orientations of the piece, each one normalized as the sorted list of its cells, to ignore duplicates.
+    int orientations[8][8][2];
+    int nb_orientations = 0;
+
+    for (int t = 0; t < (packing->reflections ? 8 : 4); t++)
+    {
+      int o[8][2], min_x = 1000, min_y = 1000;
+
+      for (int i = 0; i < size; i++)
+      {
+        int a = t & 4 ? -x[i] : x[i], b = y[i];
+
+        for (int rotation = 0; rotation < (t & 3); rotation++)
+        {
+          int tmp = a;
+
+          a = b;
+          b = -tmp;
+        }
+        o[i][0] = a, o[i][1] = b;
+        min_x = a < min_x ? a : min_x;
+        min_y = b < min_y ? b : min_y;
+      }
+      for (int i = 0; i < size; i++)
+        o[i][0] -= min_x, o[i][1] -= min_y;
+      for (int i = 1; i < size; i++)
+        for (int j = i; j > 0 && (o[j][0] < o[j - 1][0] || (o[j][0] == o[j - 1][0] && o[j][1] < o[j - 1][1])); j--)
+        {
+          int tmp[2] = { o[j][0], o[j][1] };
+
+          o[j][0] = o[j - 1][0], o[j][1] = o[j - 1][1];
+          o[j - 1][0] = tmp[0], o[j - 1][1] = tmp[1];
+        }
+
+      int duplicate = 0;
+
+      for (int u = 0; u < nb_orientations && !duplicate; u++)
+        duplicate = !memcmp (orientations[u], o, size * sizeof (*o));
+      if (!duplicate)
+        memcpy (orientations[nb_orientations++], o, size * sizeof (*o));
+    }
+
+    // Placements of the piece on the board.
+    for (int u = 0; u < nb_orientations; u++)
+      for (int r = 0; r < packing->height; r++)
+        for (int c = 0; c < packing->width; c++)
+        {
+          int fits = 1;
+
+          for (int i = 0; i < size && fits; i++)
+          {
+            int a = r + orientations[u][i][0], b = c + orientations[u][i][1];
+
+            fits = a < packing->height && b < packing->width && !(packing->holes && packing->holes[a * packing->width + b] == '#');
+            snprintf (cells[i], sizeof (cells[i]), "%i,%i", a, b);
+            elements[1 + i] = cells[i];
+          }
+          if (fits)
+          {
+            char subset[64];
+
+            snprintf (subset, sizeof (subset), "%s@%i,%i/%i", name, r, c, u);
+            dlx_subset_define (universe, subset, 1 + size, elements);
+          }
+        }
+  }
+  result->build_seconds += bench_now () - start;
+
+  bench_search (universe, result);
+  dlx_universe_destroy (universe);
+}
+
+/// A random sparse matrix: a planted solution completed by random subsets.
+struct bench_random_matrix
+{
+  unsigned long nb_elements;
+  unsigned long nb_subsets;
+  double density;               ///< Probability that a random subset contains an element.
+  unsigned long long seed;
+};
+
+static void
+bench_random_matrix (struct bench_result *result, const void *parameters)
+{
+  const struct bench_random_matrix *matrix = parameters;
+  unsigned long long state = matrix->seed;
+  double start = bench_now ();
+  char (*names)[24] = malloc (matrix->nb_elements * sizeof (*names));
+  const char **elements = malloc (matrix->nb_elements * sizeof (*elements));
+  char name[32];
+
+  for (unsigned long e = 0; e < matrix->nb_elements; e++)
+  {
+    snprintf (names[e], sizeof (names[e]), "E%lu", e);
+    elements[e] = names[e];
+  }
+
+  Universe universe = dlx_universe_create (matrix->nb_elements, elements);
+
+  dlx_trace_set (universe, 0);
+
+  // The planted solution: consecutive elements, in subsets of 1 to 4 elements.
+  unsigned long nb_subsets = 0;
+
+  for (unsigned long e = 0; e < matrix->nb_elements; nb_subsets++)
+  {
+    unsigned long length = 1 + bench_random (&state) % 4;
+
+    if (e + length > matrix->nb_elements)
+      length = matrix->nb_elements - e;
+    snprintf (name, sizeof (name), "P%lu", nb_subsets);
+    dlx_subset_define (universe, name, length, elements + e);
+    e += length;
+  }
+
+  const char **subset = malloc (matrix->nb_elements * sizeof (*subset));
+
+  for (; nb_subsets < matrix->nb_subsets; nb_subsets++)
+  {
+    unsigned long length = 0;
+
+    for (unsigned long e = 0; e < matrix->nb_elements; e++)
+      if ((bench_random (&state) >> 11) * 0x1.0p-53 < matrix->density)
+        subset[length++] = elements[e];
+    if (!length)
+      subset[length++] = elements[bench_random (&state) % matrix->nb_elements];
+    snprintf (name, sizeof (name), "S%lu", nb_subsets);
+    dlx_subset_define (universe, name, length, subset);
+  }
+  result->build_seconds += bench_now () - start;
+
+  bench_search (universe, result);
+  dlx_universe_destroy (universe);
+  free (subset);
+  free (elements);
+  free (names);
+}
+
+/// A large construction-only load: the universe is built and a search context is created, but no search is run.
+static void
+bench_construction (struct bench_result *result, const void *parameters)
+{
+  const struct bench_random_matrix *matrix = parameters;
+  unsigned long long state = matrix->seed;
+  double start = bench_now ();
+  char (*names)[24] = malloc (matrix->nb_elements * sizeof (*names));
+  const char **elements = malloc (matrix->nb_elements * sizeof (*elements));
+  const char *subset[8];
+  char name[32];
+
+  for (unsigned long e = 0; e < matrix->nb_elements; e++)
+  {
+    snprintf (names[e], sizeof (names[e]), "E%lu", e);
+    elements[e] = names[e];
+  }
+
+  Universe universe = dlx_universe_create (matrix->nb_elements, elements);
+
+  dlx_trace_set (universe, 0);
+  for (unsigned long s = 0; s < matrix->nb_subsets; s++)
+  {
+    for (unsigned long i = 0; i < sizeof (subset) / sizeof (*subset); i++)
+      subset[i] = elements[bench_random (&state) % matrix->nb_elements];
+    snprintf (name, sizeof (name), "S%lu", s);
+    dlx_subset_define (universe, name, sizeof (subset) / sizeof (*subset), subset);
+  }
+  dlx_search_context_destroy (dlx_search_context_create (universe));
+  dlx_universe_destroy (universe);
+  result->build_seconds += bench_now () - start;
+
+  free (elements);
+  free (names);
+}
+
+static const int bench_queens_10 = 10;
+static const int bench_queens_12 = 12;
+static const struct bench_packing bench_pentomino_3x20 = { 20, 3, 0, 1, bench_pentominoes };
+static const struct bench_packing bench_pentomino_8x8 = { 8, 8,
+  "........"
+  "........"
+  "........"
+  "...##..."
+  "...##..."
+  "........"
+  "........"
+  "........", 1, bench_pentominoes };
+/// The one-sided tetrominoes can not tile a 4×7 rectangle (T covers an odd number of black cells of a checkerboard): the search proves it.
+static const struct bench_packing bench_tetromino_4x7 = { 7, 4, 0, 0, bench_tetrominoes };
+static const struct bench_random_matrix bench_random_sparse = { 80, 265, 0.05, 0x9E3779B97F4A7C15ULL };
+static const struct bench_random_matrix bench_random_medium = { 60, 450, 0.10, 0x9E3779B97F4A7C15ULL };
+static const struct bench_random_matrix bench_random_dense = { 60, 3000, 0.20, 0x9E3779B97F4A7C15ULL };
+static const struct bench_random_matrix bench_construction_large = { 2000, 50000, 0, 0x9E3779B97F4A7C15ULL };
+
+static const struct bench_workload bench_workloads[] = {
+  { "sudoku-hard", bench_sudoku, 0 },
+  { "queens-10", bench_queens, &bench_queens_10 },
+  { "queens-12", bench_queens, &bench_queens_12 },
+  { "pentomino-3x20", bench_packing, &bench_pentomino_3x20 },
+  { "pentomino-8x8-hole", bench_packing, &bench_pentomino_8x8 },
+  { "tetromino-one-sided-4x7", bench_packing, &bench_tetromino_4x7 },
+  { "random-density-0.05", bench_random_matrix, &bench_random_sparse },
+  { "random-density-0.10", bench_random_matrix, &bench_random_medium },
+  { "random-density-0.20", bench_random_matrix, &bench_random_dense },
+  { "construction-2000x50000", bench_construction, &bench_construction_large },
+};
+
+/// Runs a workload in a child process, so that its peak resident set size is measured separately.
+static int
+bench_run (const struct bench_workload *workload, struct bench_result *result)
+{
+  int channel[2];
+
+  memset (result, 0, sizeof (*result));
+  if (pipe (channel))
+    return 0;
+
+  fflush (0);
+  pid_t child = fork ();
+
+  if (child < 0)
+    return 0;
+  if (!child)
+  {
+    close (channel[0]);
+    workload->run (result, workload->parameters);
+    _exit (write (channel[1], result, sizeof (*result)) != sizeof (*result));
+  }
+
+  close (channel[1]);
+  int ok = read (channel[0], result, sizeof (*result)) == sizeof (*result);
+  int status = 0;
+  struct rusage usage;
+
+  close (channel[0]);
+  if (wait4 (child, &status, 0, &usage) != child || !WIFEXITED (status) || WEXITSTATUS (status))
+    return 0;
+  result->peak_rss_kb = usage.ru_maxrss;
+
+  return ok;
+}
+
+/// Finds the result of a workload in a baseline file.
+///
+/// Times are 0 if the baseline does not hold them.
+static int
+bench_baseline (FILE *baseline, const char *name, struct bench_result *result)
+{
+  char line[1024], workload[64];
+
+  rewind (baseline);
+  while (fgets (line, sizeof (line), baseline))
+  {
+    result->build_seconds = result->search_seconds = 0;
+    if (sscanf (line, "{\"workload\": \"%63[^\"]\", \"solutions\": %lu, \"nodes\": %lu, \"updates\": %lu, \"build_seconds\": %lf, \"search_seconds\": %lf",
+                workload, &result->solutions, &result->nodes, &result->updates, &result->build_seconds, &result->search_seconds) >= 4
+        && !strcmp (workload, name))
+      return 1;
+  }
+
+  return 0;
+}
+
+/// Compares a time with the one of the baseline.
+static int
+bench_slower (double seconds, double baseline_seconds, double tolerance)
+{
+  return baseline_seconds >= BENCH_MIN_SECONDS && seconds > baseline_seconds * (1 + tolerance);
+}
+
+int
+main (int argc, char *argv[])
+{
+  FILE *baseline = argc > 1 && strcmp (argv[1], "-") ? fopen (argv[1], "r") : 0;
+  const char *times_setting = getenv ("DLX_BENCH_TIMES");
+  FILE *times = times_setting && *times_setting ? fopen (times_setting, "r") : 0;
+  const char *tolerance_setting = getenv ("DLX_BENCH_TOLERANCE");
+  double tolerance = tolerance_setting ? atof (tolerance_setting) : 0.25;
+  int regressions = 0;
+
+  if (argc > 1 && strcmp (argv[1], "-") && !baseline)
+    fprintf (stderr, "Baseline %s can not be read: results are not compared.\n", argv[1]);
+  if (times_setting && *times_setting && !times)
+    fprintf (stderr, "Local baseline %s can not be read: times are not compared.\n", times_setting);
+
+  // Searches do not trace their execution.
+  unsetenv ("DLX_TRACE");
+
+  for (size_t w = 0; w < sizeof (bench_workloads) / sizeof (*bench_workloads); w++)
+  {
+    struct bench_result result, reference;
+    int selected = argc <= 2;
+
+    for (int a = 2; a < argc && !selected; a++)
+      selected = !strcmp (argv[a], bench_workloads[w].name);
+    if (!selected)
+      continue;
+
+    if (!bench_run (&bench_workloads[w], &result))
+    {
+      printf ("{\"workload\": \"%s\", \"status\": \"failed\"}\n", bench_workloads[w].name);
+      regressions++;
+      continue;
+    }
+
+    printf ("{\"workload\": \"%s\", \"solutions\": %lu, \"nodes\": %lu, \"updates\": %lu, \"build_seconds\": %.6f, \"search_seconds\": %.6f, "
+            "\"nodes_per_second\": %.0f, \"updates_per_second\": %.0f, \"peak_rss_kb\": %ld, \"huge_page_kb\": %lu, \"search_faults\": %lu",
+            bench_workloads[w].name, result.solutions, result.nodes, result.updates, result.build_seconds, result.search_seconds,
+            result.search_seconds > 0 ? result.nodes / result.search_seconds : 0, result.search_seconds > 0 ? result.updates / result.search_seconds : 0,
+            result.peak_rss_kb, result.huge_page_kb, result.search_faults);
+
+    if (baseline || times)
+    {
+      const char *status = "ok";
+
+      // Numbers of solutions and nodes are compared with the baseline, times with the local one.
+      if (baseline && !bench_baseline (baseline, bench_workloads[w].name, &reference))
+        status = "new";
+      else if (baseline && (result.solutions != reference.solutions || result.nodes != reference.nodes))
+        status = "mismatch";
+      else if (times && bench_baseline (times, bench_workloads[w].name, &reference))
+      {
+        if (bench_slower (result.build_seconds, reference.build_seconds, tolerance)
+            || bench_slower (result.search_seconds, reference.search_seconds, tolerance))
+          status = "regression";
+        else if (reference.search_seconds > 0 && result.search_seconds > 0)
+          printf (", \"speedup\": %.3f", reference.search_seconds / result.search_seconds);
+      }
+
+      regressions += !strcmp (status, "mismatch") || !strcmp (status, "regression");
+      printf (", \"status\": \"%s\"", status);
+    }
+    printf ("}\n");
+    fflush (stdout);
+  }
+
+  if (baseline)
+    fclose (baseline);
+  if (times)
+    fclose (times);
+
+  return regressions ? 1 : 0;
+}
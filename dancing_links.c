@@ -41,23 +41,85 @@
 
 #include "dancing_links.h"
 #include <limits.h>
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#ifndef RUSAGE_THREAD
+// Declared by the C library only with _GNU_SOURCE, but supported by the system since Linux 2.6.26.
+#define RUSAGE_THREAD 1
+#endif
+#endif
 
-/// If set, the non-determistic choice (by \p dlx_universe_choose_element) of column is optimized heuristically.
+/// If set, the non-determistic choice (by \p dlx_matrix_choose_element) of column is optimized heuristically.
 #define OPTIMIZE_CHOICE 1
 
-int dlx_trace = 0;
+/// Maximum number of permutations in the group generated by declared symmetries.
+#define DLX_SYMMETRY_GROUP_MAX_SIZE 4096
+
+/// Index of the head in the node storage of a universe.
+#define HEAD 0
+
+/// Maximum length of a block of storage of names (unless a single name is longer.)
+#define DLX_NAME_POOL_MAX_CAPACITY 65536
+
+/// Number of top levels of the search whose branch positions are reported to the progress reporter.
+#define DLX_PROGRESS_LEVELS 16
+
+/// Number of nodes visited between two readings of the clock, when progress is reported periodically in time.
+#define DLX_PROGRESS_POLL_NODES 4096
+
+/// Default number of random probes of the search tree per solution drawn by random sampling.
+#define DLX_SAMPLING_PROBES 64
+
+/// Number of probes reaching no solution, per probe required per solution drawn, after which random sampling gives up.
+#define DLX_SAMPLING_MAX_MISSES 1024
+
+/// Default budget of nodes of the exact counts of the solutions of subtrees by random sampling.
+#define DLX_SAMPLING_EXACT_NODES 10000
+
+/// Size of huge pages assumed when the system does not report it.
+#define DLX_HUGE_PAGE_SIZE (2UL << 20)
+
+/// Number of slots of a bucket of the store of nogoods (a nogood is stored in one of the slots of its bucket.)
+#define DLX_NOGOOD_BUCKET 4
+
+/// Version of the format of checkpoint files.
+#define DLX_CHECKPOINT_VERSION 1
+
+/// Mean number of elements of subsets from which the dancing cells search engine is chosen automatically (without calibration.)
+#define DLX_AUTO_CELLS_SUBSET_LENGTH 8
+
+/// Maximum number of elements to be covered for propagation to be chosen automatically (propagation scans all of them at each step.)
+#define DLX_AUTO_PROPAGATION_MAX_ELEMENTS 4096
+
+/// Number of subsets from which several worker processes are recommended automatically (without calibration.)
+#define DLX_AUTO_WORKERS_MIN_SUBSETS 1000
+
+/// Default capacity (in bytes) of the buffer of a solution sink.
+#define DLX_SINK_DEFAULT_CAPACITY (1UL << 20)
 
-/// Display to terminal standard error if \p dlx_trace is set.
-#define DLX_PRINT(...) (dlx_trace ? fprintf (stderr, __VA_ARGS__) : snprintf (0, 0, __VA_ARGS__))
+/// Maximum number of bytes of an unsigned long encoded as a variable length integer.
+#define DLX_VARINT_MAX_LENGTH ((sizeof (unsigned long) * CHAR_BIT + 6) / 7)
 
-/// Call the callback function \p dlx_displayer if set.
-#define DLX_DISPLAY_SOLUTION(universe, length, solution)                                            \
-  do {                                                                                              \
-    if (universe->solution_displayer)                                                               \
-      universe->solution_displayer (universe, length, solution, universe->solution_displayer_data); \
+/// Display to terminal standard error if tracing is set for \p object (a universe or a search context).
+#define DLX_PRINT(object, ...) ((object)->trace ? fprintf (stderr, __VA_ARGS__) : snprintf (0, 0, __VA_ARGS__))
+
+/// Call the callback function \p solution_displayer of the search context if set.
+#define DLX_DISPLAY_SOLUTION(context, length, solution)                                                                        \
+  do {                                                                                                                         \
+    if (context->solution_displayer)                                                                                           \
+      context->solution_displayer ((Universe)context->universe, length, solution, context->solution_displayer_data);           \
   } while (0)
 
 /// Structure of an element (either the head or an element of the universe or an element of a subset)
@@ -82,97 +144,475 @@ int dlx_trace = 0;
 /// - a class \p S would describe elements part of subsets, inherit from class \p B extended with attributes \p elementInUnivers
 ///   (of type \p U), the element of the universe included in the subset and \p name, the name of the subset containing this element.
 ///
-/// In C, all attributes are gathered into a common structure and unnecessary attributes are left undefined.
-struct element {
-  char *name;             ///< Either the name of the head ("|HEAD|"), or of the element of the universe, or of the subset containing the element of a subset.
-  unsigned long int size; ///< Number of subsets (for head) or of subsets containing an element of the universe. Left undefined for elements of subsets.
+/// In C, elements are stored in an array (the node storage of the universe) and refer to each other by their indices in this array.
+/// An element of the node storage only holds its links (in \p struct matrix, modified by the search, so that a search context
+/// can work on its own copy of them while the universe is shared read-only) and the index of its element of the universe.
+/// The other attributes are stored once, apart from the node storage: names of elements of the universe in \p struct column,
+/// names of subsets in \p struct subset, and numbers of subsets containing elements of the universe in \p struct matrix.
+
+/// An element of the universe (a column of the sparse matrix).
+struct column {
+  char *name;         ///< Name of the element.
+  unsigned long node; ///< Index of the element in the node storage.
+  int disabled;       ///< Set if the element is disabled: it is then no longer required to be covered by solutions.
+};
+
+/// A subset (a row of the sparse matrix).
+struct subset {
+  char *name;         ///< Name of the subset.
+  unsigned long node; ///< Index of the first element of the subset in the node storage (the elements of a subset are contiguous in the node storage.)
+  int disabled;       ///< Set if the subset is disabled: it is then part of no solution.
+  double weight;      ///< Cost of the subset in a solution, for the search of the solution of minimal cost.
+  unsigned long multiplicity; ///< Number of identical subsets merged into this one (1 if none was merged.)
+  double priority;            ///< Priority of the subset, for DLX_ORDER_PRIORITY.
+};
+
+/// Links of an element, as indices in the node storage of the universe.
+struct links {
+  unsigned long int previousElement;                                        ///< Link to the previous element in universe or in the subset.
+  unsigned long int nextElement;                                            ///< Link to the previous element in universe or in the subset.
+  unsigned long int elementInPreviousSubsetContainingThisElementOfUniverse; ///< Link to the same element in the previous subset. Left undefined for head.
+  unsigned long int elementInNextSubsetContainingThisElementOfUniverse;     ///< Link to the same element in the next subset. Left undefined for head.
+};
+
+/// The sparse matrix of elements and subsets: the mutable part of the elements.
+struct matrix {
+  struct links *links;     ///< Links of the elements, by index in the node storage.
+  unsigned long int *size; ///< Number of subsets containing an element of the universe, by index of the element in the universe.
+  unsigned long updates;   ///< Number of elements of subsets removed from or restored to the matrix (statistics.)
+};
+
+/// Group of symmetries computed from the declared permutations.
+struct symmetry_group {
+  unsigned long **group;      ///< Permutations of the elements of the universe in the group (the identity first).
+  unsigned long **subset_map; ///< Permutations of the subsets induced by the permutations in \p group.
+  unsigned long group_size;   ///< Number of permutations in the group.
+
+  unsigned long root; ///< Element of the universe, left unchanged by the whole group, chosen at the first level of the search (HEAD if none.)
+};
+
+/// Symmetries of the universe.
+///
+/// Symmetries are declared as permutations of the elements of the universe (identified by their indices).
+/// Before a search, the group generated by these permutations is computed, restricted to the permutations
+/// which leave the elements already covered by required subsets globally unchanged, and its action on subsets is deduced.
+/// The search is then restricted to canonical solutions (the lexicographically smallest, as sorted lists of indices of subsets, among their images by the group.)
+struct symmetry {
+  unsigned long **generators;  ///< Declared permutations of the elements of the universe.
+  unsigned long nb_generators; ///< Number of declared permutations.
+
+  struct symmetry_group *group; ///< Group generated by \p generators (0 if not computed yet or out of date.)
+};
+
+/// Slot of the hash table of subsets.
+struct subset_slot {
+  unsigned long hash;   ///< Hash of the sorted indices of the elements of the subset.
+  unsigned long subset; ///< Index of the subset (ULONG_MAX for a free slot.)
+};
 
-  struct element *previousElement;                                        ///< Link to the previous element in universe or in the subset.
-  struct element *nextElement;                                            ///< Link to the previous element in universe or in the subset.
-  struct element *elementInPreviousSubsetContainingThisElementOfUniverse; ///< Link to the same element in the previous subset. Left undefined for head.
-  struct element *elementInNextSubsetContainingThisElementOfUniverse;     ///< Link to the same element in the next subset. Left undefined for head.
+/// Slot of the hash table of names of subsets.
+struct name_slot {
+  unsigned long hash; ///< Hash of the name.
+  const char *name;   ///< Name of a subset, or of a subset merged into an identical subset, in the storage of names (0 for a free slot.)
+  int disabled;       ///< Set if the merged subset of this name is disabled (for names of merged subsets only.)
+};
 
-  struct element *elementInUniverse; ///< Link to the element in universe. Left undefined for head and elements in universe.
+/// Block of storage of names of elements and subsets.
+///
+/// Names are never modified once stored. A block can therefore be shared by a universe and its clones.
+/// It is released when the last universe referencing it is destroyed.
+struct name_pool {
+  unsigned long references; ///< Number of universes referencing the block (updated atomically.)
+  size_t length;            ///< Used length of \p names.
+  size_t capacity;          ///< Allocated length of \p names.
+  char names[];             ///< Names, each terminated by \0.
 };
 
 /// The Univers object.
 ///
-/// Links to the first element of the universe (head), the solutions found, as well as subsets required in solutions.
+/// Holds the elements (head, elements of the universe and elements of subsets), as well as subsets required in solutions.
+/// The universe is modified by its definition (creation, definition of subsets, subsets required in solutions, symmetries) only.
+/// Searches work on search contexts, each with its own copy of the links.
 struct universe {
-  struct element *head; ///< The pointer to the head element that references elements and subsets.
+  unsigned long *columns;      ///< The node storage (the head first, then elements of the universe and elements of subsets, in order of creation): index of the element of the universe of every element. Left undefined for head.
+  unsigned long *rows;         ///< Index of the subset of every element of a subset in the node storage (ULONG_MAX for the head and elements of the universe).
+  unsigned long nb_nodes;      ///< Number of elements in the node storage.
+  unsigned long nodes_capacity; ///< Allocated length of the node storage.
+  struct matrix matrix;        ///< Links between elements, as modified by subsets required in solutions.
+
+  struct name_pool **name_pools; ///< Blocks of storage of the names of elements and subsets, possibly shared with clones.
+  unsigned long nb_name_pools;   ///< Number of blocks of storage of names.
+
+  unsigned long *uncover_column;       ///< Elements of the universe covered by subsets required in solutions.
+  unsigned long uncover_column_length; ///< Number of elements of the universe covered by subsets required in solutions.
 
-  char **solution;               ///< Buffer to store the current solution (a list of names of subsets.)
-  unsigned long solution_length; ///< Length of the buffer (number of subsets in solution.)
+  unsigned long *required_subsets;   ///< Indices of the subsets required in solutions, in order of requirement.
+  const char **required_names;       ///< Names by which the subsets required in solutions were required (names of merged subsets included.)
+  unsigned long nb_required_subsets; ///< Number of subsets required in solutions.
 
-  struct element **uncover_column;     ///< List of subsets required in solutions (an element of this subset.)
-  unsigned long uncover_column_length; ///< Number of subsets required in solutions.
+  unsigned long *assumptions;   ///< Stack of assumptions: number of subsets required in solutions when each level was pushed.
+  unsigned long nb_assumptions; ///< Number of levels in the stack of assumptions.
+
+  struct dlx_conflict conflict; ///< Why the last subset could not be required in solutions.
 
   dlx_solution_displayer solution_displayer; ///< Callback function to display a solution
 
   void *solution_displayer_data; ///< Data usable for callback function to display a solution
 
   int unbound; ///< The universe boundaries expand to the boundaries of its subsets.
+
+  struct subset_slot *subset_table;    ///< Hash table of the subsets, by their elements, to merge identical subsets (0 if identical subsets are not merged.)
+  unsigned long subset_table_capacity; ///< Number of slots of the hash table of the subsets (a power of 2.)
+  unsigned long nb_duplicates;         ///< Number of subsets merged into an identical subset.
+  struct name_slot *name_table;        ///< Hash table of the names of subsets and of subsets merged into an identical subset under another name.
+  unsigned long name_table_capacity;   ///< Number of slots of the hash table of names (0 or a power of 2.)
+  unsigned long name_table_length;     ///< Number of names in the hash table of names.
+
+  int trace; ///< Trace execution on standard error terminal if set.
+
+  int propagation;            ///< Default propagation setting of search contexts.
+  unsigned long nb_forced;    ///< Number of subsets forced by propagation during the last search.
+  unsigned long nb_dead_ends; ///< Number of dead ends detected by propagation during the last search.
+
+  double cost; ///< Cost of the solution found by the last search of the solution of minimal cost (HUGE_VAL if none.)
+
+  unsigned long max_length;        ///< Default maximal number of subsets in solutions of search contexts (0 if unlimited.)
+  unsigned long max_subset_length; ///< Number of elements of the longest subset.
+
+  SolutionSink sink; ///< Default solution sink of search contexts (0 if solutions are displayed.)
+
+  enum dlx_engine engine; ///< Default search engine of search contexts.
+
+  enum dlx_subset_order subset_order; ///< Default order of subsets of search contexts.
+
+  int memory_policy; ///< Memory policy of the links of search contexts.
+
+  unsigned long calibration_nodes; ///< Default budget of nodes of the calibration of the automatic selection of search contexts.
+  struct dlx_auto_choice choice;   ///< Choice of the automatic selection of the last search (\p nb_workers is 0 if none.)
+
+  struct column *elements;   ///< Elements of the universe, by index (in order of declaration.)
+  unsigned long nb_elements; ///< Number of elements of the universe.
+
+  struct subset *subsets;   ///< Subsets, by index (in order of definition.)
+  unsigned long nb_subsets; ///< Number of subsets defined.
+
+  struct symmetry *symmetry; ///< Symmetries of the universe (0 if none was declared.)
+
+  unsigned long nb_solutions_total; ///< Number of solutions, symmetric images included, found by the last search.
+};
+
+/// Store of nogoods: hashes of sets of covered elements whose subproblem has no solution.
+///
+/// Sets of covered elements are hashed twice (Zobrist hashing): the first hash selects a bucket, both are stored and compared.
+/// The hash of a set is the exclusive or of the hashes of its elements, so that it is updated when a subset is covered or uncovered by the search.
+struct nogood_store {
+  unsigned long long (*slots)[2]; ///< Hashes of the nogoods, by bucket of DLX_NOGOOD_BUCKET slots ({0, 0} if empty.)
+  unsigned long nb_buckets;       ///< Number of buckets (a power of 2.)
+  unsigned long long (*subset_keys)[2]; ///< Hashes of the elements of each subset.
+  unsigned long long key[2];            ///< Hash of the elements covered by the current path of the search.
+};
+
+/// The search context object.
+///
+/// Holds the mutable state of a search on a universe: a private copy of the links between elements,
+/// the current partial solution and the settings of the search.
+/// Several search contexts can search the same universe concurrently.
+struct search_context {
+  const struct universe *universe; ///< The universe searched, shared read-only.
+  struct matrix matrix;            ///< Private copy of the links of the universe.
+
+  unsigned long *solutions; ///< Element of the subset chosen at each level of the search.
+  const char **solution;    ///< Buffer to store the current solution (a list of names of subsets, the required ones first.)
+
+  dlx_solution_displayer solution_displayer; ///< Callback function to display a solution
+
+  void *solution_displayer_data; ///< Data usable for callback function to display a solution
+
+  int trace; ///< Trace execution on standard error terminal if set.
+
+  const struct symmetry_group *symmetry; ///< Group of symmetries of the universe (0 if none.)
+  struct symmetry_group *own_symmetry;   ///< Group of symmetries computed for this search context only (0 if shared with the universe.)
+  unsigned long root_subset;             ///< Index of the subset containing the root of the group currently tried at the first level of the search.
+  unsigned long root_weight;             ///< Number of subsets in the orbit of \p root_subset.
+  unsigned long *canonical;              ///< Buffer for the sorted indices of the subsets of a solution.
+  unsigned long *image;                  ///< Buffer for the sorted indices of the subsets of an image of a solution.
+
+  unsigned long nb_solutions_total; ///< Number of solutions, symmetric images included, found by the last search.
+  unsigned long nb_solutions;       ///< Number of solutions found by the last search.
+  unsigned long nb_nodes;           ///< Number of nodes of the search tree visited by the last search.
+
+  int propagation;              ///< Forced subsets are taken and dead ends are detected right after each choice if set.
+  unsigned long nb_forced;      ///< Number of subsets forced by propagation during the last search.
+  unsigned long nb_dead_ends;   ///< Number of dead ends detected by propagation during the last search.
+  unsigned long nb_path_forced; ///< Number of subsets forced by propagation on the current path of the search.
+
+  double *share;             ///< Share of the weight of its subset of every element of a subset (only while searching for the solution of minimal cost.)
+  double *path_cost;         ///< Cost of the solution at each level of the search (only while searching for the solution of minimal cost.)
+  unsigned long *best;       ///< Element of the subset chosen at each level of the best solution found so far.
+  unsigned long best_length; ///< Number of subsets in the best solution found so far.
+  double best_cost;          ///< Cost of the best solution found so far (HUGE_VAL if none.)
+
+  unsigned long max_length; ///< Maximal number of subsets in solutions, required subsets included (0 if unlimited.)
+  int deepening;            ///< Set while the length of solutions is deepened: searches which find no solution do not report it.
+
+  SolutionSink sink; ///< Solution sink where solutions are written instead of being displayed (0 if none.)
+
+  enum dlx_engine engine; ///< Search engine.
+
+  enum dlx_subset_order subset_order; ///< Order in which subsets are tried.
+  int reordered;                      ///< Set if the links of subsets are not in order of definition.
+  unsigned long *failures;            ///< Number of branches without solution of each subset (0 until counted, with DLX_ORDER_FAILURES.)
+
+  struct nogood_store *nogoods; ///< Store of nogoods (0 if none.)
+  int nogoods_active;           ///< Set if the current search records and uses nogoods.
+  struct dlx_nogood_statistics nogood_statistics; ///< Statistics of the store of nogoods.
+
+  size_t memory_length;                ///< Length of the mapping of the links (0 if allocated by malloc.)
+  struct dlx_memory_statistics memory; ///< Memory statistics of the links.
+  int memory_stale;                    ///< Set if the huge pages backing the links are to be read again from the system.
+
+  unsigned long calibration_nodes; ///< Budget of nodes of each calibration run of the automatic selection (0 if no calibration.)
+  struct dlx_auto_choice choice;   ///< Choice of the automatic selection of the last search (\p nb_workers is 0 if none.)
+  struct dlx_auto_choice calibrated;         ///< Outcome of the last calibration (\p calibration_nodes is 0 if none was run.)
+  unsigned long long calibrated_fingerprint; ///< Fingerprint of the model and settings of the last calibration.
+  int calibrated_one_only;                   ///< Set if the last calibration was run for the first solution only.
+  int calibrated_cells;                      ///< Set if the last calibration tried the dancing cells engine.
+  unsigned long node_limit;        ///< Number of visited nodes at which the search is stopped (ULONG_MAX if none.)
+
+  dlx_search_event_handler event_handler; ///< Callback function notified of the subsets added to and removed from the solution (0 if none.)
+  void *event_data;                       ///< Data usable for callback function notified of the events of the search.
+
+  char *checkpoint_file;                             ///< File where the frontier of the search is saved (0 if none.)
+  unsigned long checkpoint_interval;                 ///< Number of nodes visited between two checkpoints (0 for checkpoints on request only.)
+  volatile sig_atomic_t checkpoint_requested;        ///< Set to save a checkpoint at the next node of the search.
+  volatile sig_atomic_t stop_requested;              ///< Set to stop the search at the next node of the search, after the checkpoint.
+  int interrupted;                                   ///< Set if the last search was stopped before completion.
+  unsigned long *resume_path;                        ///< Index of the subset chosen at each level of the frontier to resume from.
+  unsigned long resume_length;                       ///< Number of levels of the frontier to resume from (0 if none.)
+  int resume_complete;                               ///< Set if the search to resume from was already completed.
+  unsigned long prefix_length;                       ///< Number of levels of the frontier fixed by a job (0 if the whole search is run.)
+
+  unsigned long split_depth; ///< Depth at which the search is split into jobs (ULONG_MAX if the search is not being split.)
+  const char *split_name;    ///< Prefix of the names of the job files.
+  unsigned long nb_jobs;     ///< Number of jobs written by the split.
+  FILE *result;              ///< File where the solutions of a job are recorded (0 if solutions are displayed.)
+
+  unsigned long next_poll;       ///< Number of visited nodes at which periodic tasks (checkpoints, progress reports) are run next (ULONG_MAX if none.)
+  unsigned long next_checkpoint; ///< Number of visited nodes at which the next periodic checkpoint is saved.
+
+  dlx_progress_reporter progress_reporter;                 ///< Callback function to report the progress of the search (0 if none.)
+  void *progress_data;                                     ///< Data usable for callback function to report the progress of the search.
+  unsigned long progress_interval;                         ///< Number of nodes visited between two progress reports (0 if none.)
+  unsigned long progress_milliseconds;                     ///< Time between two progress reports (0 if none.)
+  unsigned long next_progress;                             ///< Number of visited nodes at which progress is reported next.
+  double next_progress_time;                               ///< Time (in milliseconds) at which progress is reported next.
+  unsigned long progress_levels;                           ///< Number of top levels of the search whose branch positions are kept (0 if progress is not reported.)
+  unsigned long progress_position[DLX_PROGRESS_LEVELS];    ///< Position (from 0) of the subset tried at each top level, among the subsets containing the chosen element.
+  unsigned long progress_branches[DLX_PROGRESS_LEVELS];    ///< Number of subsets containing the element chosen at each top level.
+
+  unsigned long sampling_probes;                  ///< Number of random probes of the search tree reaching a solution per solution drawn.
+  unsigned long sampling_exact_nodes;             ///< Budget of nodes of the exact counts of subtrees (0 if none.)
+  unsigned long sampling_exact_level;             ///< Level of the search tree from which subtrees are counted exactly (adapted from probe to probe.)
+  unsigned long long random_state;                ///< State of the pseudo-random generator of random sampling.
+  unsigned long *sample;                          ///< Element of the subset chosen at each level of the solution drawn so far (0 until sampling.)
+  struct dlx_sampling_quality sampling_quality;   ///< Quality of the solutions drawn by the last random sampling.
+};
+
+/// The solution sink object.
+///
+/// Solutions are written to a buffer as lists of indices of subsets, encoded as variable length integers
+/// (7 bits per byte, least significant first, the high bit set on all bytes but the last).
+/// Each solution is delta-encoded against the previous one written to the sink: a record is made of
+/// the number of leading subsets shared with the previous solution, the number of subsets which follow,
+/// and the indices of those subsets. The buffer is handed to the writer of the sink when full.
+struct solution_sink {
+  dlx_sink_writer writer; ///< Function called to write the buffer.
+  void *data;             ///< Data usable by the writer.
+  FILE *file;             ///< File written by the default writer (0 if a writer was given.)
+
+  unsigned char *buffer;  ///< Encoded solutions not yet written.
+  unsigned long size;     ///< Number of bytes in the buffer.
+  unsigned long capacity; ///< Capacity of the buffer, in bytes.
+
+  unsigned long *previous;         ///< Indices of the subsets of the previous solution written.
+  unsigned long previous_length;   ///< Number of subsets of the previous solution written.
+  unsigned long previous_capacity; ///< Capacity of \p previous.
+
+  unsigned long nb_solutions; ///< Number of solutions written to the sink.
+  int failed;                 ///< Set if the writer failed.
 };
 
 /// Gets an element by its name.
-/// @param [in] head Univers head
+/// @param [in] universe Universe
 /// @param [in] element_name Name of the element in universe to be fetched
-static struct element *
-dlx_head_get_element_by_name (struct element *head, const char *element_name) {
-  struct element *element = 0;
+/// @return Index of the element in the node storage, or HEAD if the element is unknown (or covered by a required subset).
+///
+/// Disabled elements are found as well, even if covered by a required subset.
+static unsigned long
+dlx_universe_get_element_by_name (const struct universe *universe, const char *element_name) {
+  const struct links *links = universe->matrix.links;
+  unsigned long element = HEAD;
 
-  for (element = head->nextElement; element != head && strcmp (element->name, element_name);
-       element = element->nextElement)
+  for (element = links[HEAD].nextElement; element != HEAD && strcmp (universe->elements[universe->columns[element]].name, element_name);
+       element = links[element].nextElement)
     /**/;
-  if (element != head)
-    return element;
-  else
-    return 0;
+
+  for (unsigned long i = 0; element == HEAD && i < universe->nb_elements; i++)
+    if (universe->elements[i].disabled && !strcmp (universe->elements[i].name, element_name))
+      element = universe->elements[i].node;
+
+  return element;
 }
 
-/// Adds an element in the universe.
-/// @param [in] head Univers head
-/// @param [in] name Name of the element to be added
-static int
-dlx_head_add_element (struct element *head, const char *name) {
-  if (dlx_head_get_element_by_name (head, name))
-    return 0;
+/// Reserves storage in the blocks of storage of names of the universe.
+/// @param [in] universe Universe
+/// @param [in] size Number of bytes reserved
+/// @param [in] alignment Alignment of the reserved storage (a power of 2, at most the alignment of unsigned long.)
+/// @return Reserved storage, released with the universe.
+static void *
+dlx_universe_name_reserve (Universe universe, size_t size, size_t alignment) {
+  struct name_pool *pool = universe->nb_name_pools ? universe->name_pools[universe->nb_name_pools - 1] : 0;
+  size_t offset = pool ? (pool->length + alignment - 1) & ~(alignment - 1) : 0;
+
+  // Names are appended to the last block, unless it is full or shared with a clone.
+  if (!pool || offset + size > pool->capacity || __atomic_load_n (&pool->references, __ATOMIC_ACQUIRE) > 1) {
+    size_t capacity = pool && 2 * pool->capacity < DLX_NAME_POOL_MAX_CAPACITY ? 2 * pool->capacity : pool ? DLX_NAME_POOL_MAX_CAPACITY : 256;
+
+    if (capacity < size)
+      capacity = size;
+
+    pool = malloc (sizeof (*pool) + capacity);
+    pool->references = 1;
+    pool->length = 0;
+    pool->capacity = capacity;
+    offset = 0;
+
+    universe->nb_name_pools++;
+    universe->name_pools = realloc (universe->name_pools, universe->nb_name_pools * sizeof (*universe->name_pools));
+    universe->name_pools[universe->nb_name_pools - 1] = pool;
+  }
+
+  pool->length = offset + size;
+  return pool->names + offset;
+}
+
+/// Copies a name in the storage of names of the universe.
+/// @param [in] universe Universe
+/// @param [in] name Name to be copied
+/// @return Copy of the name, released with the universe.
+static char *
+dlx_universe_name_copy (Universe universe, const char *name) {
+  size_t length = strlen (name) + 1;
+
+  return memcpy (dlx_universe_name_reserve (universe, length, 1), name, length);
+}
+
+/// Copies the name of a subset in the storage of names of the universe.
+/// @param [in] universe Universe
+/// @param [in] name Name to be copied
+/// @param [in] subset Index of the subset
+/// @return Copy of the name, released with the universe.
+///
+/// The index of the subset is stored right before its name, so that dlx_subset_index() finds the subset of a name of a solution without looking for it.
+static char *
+dlx_universe_subset_name_copy (Universe universe, const char *name, unsigned long subset) {
+  size_t length = strlen (name) + 1;
+  unsigned long *copy = dlx_universe_name_reserve (universe, sizeof (subset) + length, _Alignof (unsigned long));
+
+  *copy = subset;
+  return memcpy (copy + 1, name, length);
+}
+
+/// Allocates a new element in the node storage of the universe.
+/// @param [in] universe Universe
+/// @return Index of the new element.
+static unsigned long
+dlx_universe_new_node (Universe universe) {
+  if (universe->nb_nodes == universe->nodes_capacity) {
+    universe->nodes_capacity = universe->nodes_capacity ? 2 * universe->nodes_capacity : 64;
+    universe->columns = realloc (universe->columns, universe->nodes_capacity * sizeof (*universe->columns));
+    universe->rows = realloc (universe->rows, universe->nodes_capacity * sizeof (*universe->rows));
+    universe->matrix.links = realloc (universe->matrix.links, universe->nodes_capacity * sizeof (*universe->matrix.links));
+  }
+
+  universe->rows[universe->nb_nodes] = ULONG_MAX;
+  return universe->nb_nodes++;
+}
 
+/// Appends an element to the universe, without checking that its name is unique.
+/// @param [in] universe Universe
+/// @param [in] name Name of the element to be added
+/// @return Index of the element in the node storage.
+static unsigned long
+dlx_universe_append_element (Universe universe, const char *name) {
   /// Initializes the element in the universe.
-  struct element *element = malloc (sizeof (*element));
+  unsigned long element = dlx_universe_new_node (universe);
+  struct links *links = universe->matrix.links;
 
-  element->name = strdup (name);
+  /// Elements of the universe are indexed in order of declaration.
+  unsigned long index = universe->nb_elements++;
 
-  element->size = 0;
+  universe->columns[element] = index;
+  universe->elements = realloc (universe->elements, universe->nb_elements * sizeof (*universe->elements));
+  universe->elements[index].name = dlx_universe_name_copy (universe, name);
+  universe->elements[index].node = element;
+  universe->elements[index].disabled = 0;
+  universe->matrix.size = realloc (universe->matrix.size, universe->nb_elements * sizeof (*universe->matrix.size));
+  universe->matrix.size[index] = 0;
 
-  element->elementInPreviousSubsetContainingThisElementOfUniverse = element->elementInNextSubsetContainingThisElementOfUniverse = element;
+  links[element].elementInPreviousSubsetContainingThisElementOfUniverse = links[element].elementInNextSubsetContainingThisElementOfUniverse = element;
 
   /// The head and elements of universe are doubly linked as circular lists (\p previousElement and \p nextElement).
-  element->nextElement = head;
-  element->previousElement = head->previousElement;
+  links[element].nextElement = HEAD;
+  links[element].previousElement = links[HEAD].previousElement;
 
-  head->previousElement->nextElement = element;
-  head->previousElement = element;
+  links[links[HEAD].previousElement].nextElement = element;
+  links[HEAD].previousElement = element;
 
   // Other unused components of element are left undefined.
+  return element;
+}
+
+/// Adds an element in the universe.
+/// @param [in] universe Universe
+/// @param [in] name Name of the element to be added
+static int
+dlx_universe_add_element (Universe universe, const char *name) {
+  if (dlx_universe_get_element_by_name (universe, name) != HEAD)
+    return 0;
+
+  dlx_universe_append_element (universe, name);
   return 1;
 }
 
+/// Gets the subset containing an element of a subset.
+/// @param [in] universe Universe
+/// @param [in] elementInSubset Index of the element of a subset in the node storage
+/// @return Index of the subset (in order of definition).
+///
+/// The index of its subset is stored with every element of a subset, since it is needed at every node of searches.
+static unsigned long
+dlx_universe_subset_of (const struct universe *universe, unsigned long elementInSubset) {
+  return universe->rows[elementInSubset];
+}
+
 /// Chooses an element in the universe.
-/// @param [in] head Univers head
+/// @param [in] matrix Links between elements
+/// @param [in] columns Indices of the elements of the universe of the elements of the node storage
 /// @return Chosen element in universe
 /// @note Makes use of flag #OPTIMIZE_CHOICE to select the element with the minimal number of subsets that contain it (if set) or the first element, in order of the elements declared in the universe (if not).
-static struct element *
-dlx_head_choose_element (struct element *head) {
-  struct element *element = head->nextElement; // Default choice in case j->Size would not be equal to ULONG_MAX for any element.
+static unsigned long
+dlx_matrix_choose_element (const struct matrix *matrix, const unsigned long *columns) {
+  const struct links *links = matrix->links;
+  unsigned long element = links[HEAD].nextElement; // Default choice in case j->Size would not be equal to ULONG_MAX for any element.
 
 #if OPTIMIZE_CHOICE
   unsigned long s = ULONG_MAX;
 
-  for (struct element *j = head->nextElement; j != head; j = j->nextElement)
-    if (j->size < s) {
+  for (unsigned long j = links[HEAD].nextElement; j != HEAD; j = links[j].nextElement)
+    if (matrix->size[columns[j]] < s) {
       element = j;
-      s = j->size;
+      s = matrix->size[columns[j]];
     }
 #else
 #warning The non-determistic choice of column is not optimized heuristically.
@@ -182,505 +622,5021 @@ dlx_head_choose_element (struct element *head) {
 }
 
 /// Removes an element and all the elements of subsets which contain this element.
+/// @param [in] matrix Links between elements
+/// @param [in] columns Indices of the elements of the universe of the elements of the node storage
 /// @param [in] elementInUniverse Element to be removed.
-/// @post User must call dlx_element_uncover(struct element *elementInUnivers) later.
+/// @post User must call dlx_element_uncover(struct matrix *matrix, const unsigned long *columns, unsigned long elementInUniverse) later.
 ///
 /// Removes the element from the universe.
 /// The elements in subsets that contains this element are also removed from the universe.
 static void
-dlx_element_cover (struct element *elementInUniverse) {
-  elementInUniverse->nextElement->previousElement = elementInUniverse->previousElement;
-  elementInUniverse->previousElement->nextElement = elementInUniverse->nextElement;
+dlx_element_cover (struct matrix *matrix, const unsigned long *columns, unsigned long elementInUniverse) {
+  struct links *links = matrix->links;
+
+  links[links[elementInUniverse].nextElement].previousElement = links[elementInUniverse].previousElement;
+  links[links[elementInUniverse].previousElement].nextElement = links[elementInUniverse].nextElement;
+
+  unsigned long updates = 0;
 
-  for (struct element *i = elementInUniverse->elementInNextSubsetContainingThisElementOfUniverse; i != elementInUniverse; i = i->elementInNextSubsetContainingThisElementOfUniverse) // all subsets containing the element.
-    for (struct element *j = i->nextElement; j != i; j = j->nextElement)                                                                                                             // all other elements in the subset
+  for (unsigned long i = links[elementInUniverse].elementInNextSubsetContainingThisElementOfUniverse; i != elementInUniverse; i = links[i].elementInNextSubsetContainingThisElementOfUniverse) // all subsets containing the element.
+    for (unsigned long j = links[i].nextElement; j != i; j = links[j].nextElement)                                                                                                     // all other elements in the subset
     {
-      j->elementInNextSubsetContainingThisElementOfUniverse->elementInPreviousSubsetContainingThisElementOfUniverse = j->elementInPreviousSubsetContainingThisElementOfUniverse;
-      j->elementInPreviousSubsetContainingThisElementOfUniverse->elementInNextSubsetContainingThisElementOfUniverse = j->elementInNextSubsetContainingThisElementOfUniverse;
-      j->elementInUniverse->size--; // The number of subsets containing this element is decremented.
+      links[links[j].elementInNextSubsetContainingThisElementOfUniverse].elementInPreviousSubsetContainingThisElementOfUniverse = links[j].elementInPreviousSubsetContainingThisElementOfUniverse;
+      links[links[j].elementInPreviousSubsetContainingThisElementOfUniverse].elementInNextSubsetContainingThisElementOfUniverse = links[j].elementInNextSubsetContainingThisElementOfUniverse;
+      matrix->size[columns[j]]--; // The number of subsets containing this element is decremented.
+      updates++;
     }
+
+  matrix->updates += updates;
 }
 
 /// Restores an element and all the elements of subsets which contain this element.
+/// @param [in] matrix Links between elements
+/// @param [in] columns Indices of the elements of the universe of the elements of the node storage
 /// @param [in] elementInUniverse Element to be restored.
-/// @pre Use dlx_element_cover(struct element *elementInUnivers) first.
+/// @pre Use dlx_element_cover(struct matrix *matrix, const unsigned long *columns, unsigned long elementInUniverse) first.
 static void
-dlx_element_uncover (struct element *elementInUniverse) {
-  for (struct element *i = elementInUniverse->elementInPreviousSubsetContainingThisElementOfUniverse;
-       i != elementInUniverse; i = i->elementInPreviousSubsetContainingThisElementOfUniverse)
-    for (struct element *j = i->previousElement; j != i; j = j->previousElement) {
-      j->elementInUniverse->size++; // The number of subsets containing this element is incremented.
-      j->elementInPreviousSubsetContainingThisElementOfUniverse->elementInNextSubsetContainingThisElementOfUniverse = j;
-      j->elementInNextSubsetContainingThisElementOfUniverse->elementInPreviousSubsetContainingThisElementOfUniverse = j;
+dlx_element_uncover (struct matrix *matrix, const unsigned long *columns, unsigned long elementInUniverse) {
+  struct links *links = matrix->links;
+  unsigned long updates = 0;
+
+  for (unsigned long i = links[elementInUniverse].elementInPreviousSubsetContainingThisElementOfUniverse;
+       i != elementInUniverse; i = links[i].elementInPreviousSubsetContainingThisElementOfUniverse)
+    for (unsigned long j = links[i].previousElement; j != i; j = links[j].previousElement) {
+      matrix->size[columns[j]]++; // The number of subsets containing this element is incremented.
+      links[links[j].elementInPreviousSubsetContainingThisElementOfUniverse].elementInNextSubsetContainingThisElementOfUniverse = j;
+      links[links[j].elementInNextSubsetContainingThisElementOfUniverse].elementInPreviousSubsetContainingThisElementOfUniverse = j;
+      updates++;
     }
 
-  elementInUniverse->previousElement->nextElement = elementInUniverse;
-  elementInUniverse->nextElement->previousElement = elementInUniverse;
+  matrix->updates += updates;
+
+  links[links[elementInUniverse].previousElement].nextElement = elementInUniverse;
+  links[links[elementInUniverse].nextElement].previousElement = elementInUniverse;
 }
 
-/// Displays a solution.
+/// Appends an unsigned integer, encoded as a variable length integer, to a buffer.
+/// @param [in] buffer Buffer, with room for at least DLX_VARINT_MAX_LENGTH bytes.
+/// @param [in] value Integer to encode.
+/// @return Number of bytes appended.
+static unsigned long
+dlx_varint_encode (unsigned char *buffer, unsigned long value) {
+  unsigned long length = 0;
+
+  for (; value >= 0x80; value >>= 7)
+    buffer[length++] = (unsigned char)(value | 0x80);
+  buffer[length++] = (unsigned char)value;
+
+  return length;
+}
+
+/// Reads an unsigned integer, encoded as a variable length integer, from a file.
+/// @param [in] file File
+/// @param [out] value Integer decoded.
+/// @return 1 if successful, 0 at end of file or on a malformed integer.
+static int
+dlx_varint_read (FILE *file, unsigned long *value) {
+  *value = 0;
+  for (unsigned long shift = 0; shift < sizeof (*value) * CHAR_BIT; shift += 7) {
+    int byte = getc (file);
+
+    if (byte == EOF)
+      return 0;
+    *value |= (unsigned long)(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return 1;
+  }
+
+  return 0;
+}
+
+/// Writes the buffer of a solution sink with its writer, and empties it.
+/// @param [in] sink Solution sink
+static void
+dlx_sink_write_buffer (SolutionSink sink) {
+  if (sink->size && !sink->failed)
+    sink->failed = !sink->writer (sink->buffer, sink->size, sink->data);
+  sink->size = 0;
+}
+
+/// Writes a solution to a solution sink.
+/// @param [in] sink Solution sink
 /// @param [in] universe Universe
-/// @param [in] solutions Solutions to be dispplayed. Each solution is a list of elements.
+/// @param [in] solutions Element of the subset chosen at each level of the search.
+/// @param [in] length Number of subsets chosen by the search in the solution (subsets required in solutions excluded.)
 static void
-dlx_universe_display_solutions (Universe universe, struct element **solutions) {
-  unsigned long length = universe->solution_length - universe->head->size;
+dlx_sink_write_solution (SolutionSink sink, const struct universe *universe, const unsigned long *solutions, unsigned long length) {
+  unsigned long nb_required = universe->nb_required_subsets;
+  unsigned long total = nb_required + length;
 
-  for (unsigned long i = universe->solution_length - universe->head->size; i < universe->solution_length; i++) {
-    free (universe->solution[i]);
-    universe->solution[i] = 0;
+  if (total > sink->previous_capacity) {
+    sink->previous_capacity = 2 * total;
+    sink->previous = realloc (sink->previous, sink->previous_capacity * sizeof (*sink->previous));
   }
 
-  DLX_PRINT ("Exact cover solution:\n");
-  if (!universe->head->size || !solutions || !solutions[0]) {
-    DLX_PRINT ("  Already exactly covered. No more subsets required.\n");
-  } else {
-    for (unsigned long k = 0; k < universe->head->size && solutions[k]; k++) {
-      DLX_PRINT ("  [%lu]\tSubset %s:", universe->solution_length - universe->head->size + k + 1, *solutions[k]->name ? solutions[k]->name : "(unnamed)"); // line name
-      struct element *elementInSubset = solutions[k];
-
-      do {
-        DLX_PRINT (" %s", elementInSubset->elementInUniverse->name); // name pf element
-        elementInSubset = elementInSubset->nextElement;
-      } while (elementInSubset != solutions[k]);
+  // The leading subsets shared with the previous solution are counted, while the solution replaces the previous one.
+  unsigned long prefix = 0;
 
-      DLX_PRINT ("\n");
+  for (unsigned long k = 0; k < total; k++) {
+    unsigned long subset = k < nb_required ? universe->required_subsets[k] : dlx_universe_subset_of (universe, solutions[k - nb_required]);
 
-      universe->solution[universe->solution_length - universe->head->size + k] = strdup (solutions[k]->name);
-      length++;
-    }
+    if (prefix == k && k < sink->previous_length && sink->previous[k] == subset)
+      prefix++;
+    sink->previous[k] = subset;
   }
+  sink->previous_length = total;
 
-  // Why can't it be passed a char ** to a function which expects a const char ** (Warning : discards qualifiers in nested pointer types) ?
-  // The reason that you cannot assign a char ** value to a const char ** pointer in C is somewhat obscure.
-  // It is allowed in C++, but not in C. References: ISO Sec. 6.1.2.6, Sec. 6.3.16.1, Sec. 6.5.3.
-  DLX_DISPLAY_SOLUTION (universe, length, (const char *const *)universe->solution);
+  unsigned long needed = (2 + total - prefix) * DLX_VARINT_MAX_LENGTH;
 
-  for (unsigned long i = universe->solution_length - universe->head->size; i < universe->solution_length; i++) {
-    free (universe->solution[i]);
-    universe->solution[i] = 0;
+  if (sink->size + needed > sink->capacity)
+    dlx_sink_write_buffer (sink);
+  if (needed > sink->capacity) {
+    sink->capacity = needed;
+    sink->buffer = realloc (sink->buffer, sink->capacity);
   }
+
+  sink->size += dlx_varint_encode (sink->buffer + sink->size, prefix);
+  sink->size += dlx_varint_encode (sink->buffer + sink->size, total - prefix);
+  for (unsigned long k = prefix; k < total; k++)
+    sink->size += dlx_varint_encode (sink->buffer + sink->size, sink->previous[k]);
+  sink->nb_solutions++;
 }
 
-/// Recursive function to search for solutions.
-/// @param [in] universe Universe
-/// @param [in] solutions Solution to be dispplayed.
-/// @param [in] k Depth of search
-/// @param [in] one_only If set, searches for the first solution only.
-/// @return Number of solutions found.
-static unsigned long
-dlx_universe_search (Universe universe, struct element **solutions, unsigned long k, int one_only) {
-  // If there is no more element in the universe, this means all elements have been covered successfully.
-  // We have found a solution that we can display.
-  if (universe->head->nextElement == universe->head) {
-    dlx_universe_display_solutions (universe, solutions);
-    return 1;
+/// Displays a solution.
+/// @param [in] context Search context
+/// @param [in] length Number of subsets chosen by the search in the solution (subsets required in solutions excluded.)
+static void
+dlx_search_display_solution (SearchContext context, unsigned long length) {
+  const struct universe *universe = context->universe;
+  const struct links *links = context->matrix.links;
+  unsigned long nb_required = universe->nb_required_subsets;
+
+  // Solutions of a job are recorded, as indices of subsets, to be displayed (or written to the sink) when the results of the jobs are merged.
+  if (context->result) {
+    fprintf (context->result, "solution %lu", length);
+    for (unsigned long k = 0; k < length; k++)
+      fprintf (context->result, " %lu", dlx_universe_subset_of (universe, context->solutions[k]));
+    fprintf (context->result, "\n");
+    return;
   }
 
-  // Otherwise, we search for an exact cover search: a group of subsets such that the union of them
-  // contains all the elements of the universe and any intersection between two of them is empty.
-
-  int solution_found = 0;
+  // Solutions written to a sink are neither traced nor displayed.
+  if (context->sink) {
+    dlx_sink_write_solution (context->sink, universe, context->solutions, length);
+    return;
+  }
 
-  // We peek an element deterministically (all elements will have been peeked sucessively at last.)
-  // We keep a reference to the uncovered element for further access.
-  struct element *c = dlx_head_choose_element (universe->head);
+  DLX_PRINT (context, "Exact cover solution:\n");
+  if (!length) {
+    DLX_PRINT (context, "  Already exactly covered. No more subsets required.\n");
+  } else {
+    for (unsigned long k = 0; k < length; k++) {
+      unsigned long r = context->solutions[k];
+      const char *name = universe->subsets[dlx_universe_subset_of (universe, r)].name;
 
-  // We can remove this element from the universe, since we will retain one of the subsets containig it in the solution
-  // and we won't have to consider this element anymore.
-  dlx_element_cover (c);
+      DLX_PRINT (context, "  [%lu]\tSubset %s:", nb_required + k + 1, *name ? name : "(unnamed)"); // line name
+      unsigned long elementInSubset = r;
 
-  // One and only one of the subsets containing this element will have to be included in the solution.
-  // One after the other, we try to keep each subset containing the element in the solution,
-  // one after the other, nondeterministically.
-  for (struct element *r = c->elementInNextSubsetContainingThisElementOfUniverse; r != c;
-       r = r->elementInNextSubsetContainingThisElementOfUniverse) {
-    // We consider, as a trial-and-error approach, that the subset containing the element is part of the solution.
-    solutions[k] = r;
+      do {
+        DLX_PRINT (context, " %s", universe->elements[universe->columns[elementInSubset]].name); // name pf element
+        elementInSubset = links[elementInSubset].nextElement;
+      } while (elementInSubset != r);
 
-    // This subset containing the element might also contain other elements which are
-    // de facto included in the solution.
-    for (struct element *j = r->nextElement; j != r; j = j->nextElement) {
-      // We won't have to search for a valid element in these columns containing j.
-      // We can therefore remove these columns from the matrix.
+      DLX_PRINT (context, "\n");
 
-      // Furthermore, the solution can not contain other subsets that
-      // contain the same elements, otherwise,
-      // there would be more than one subset containig the same element in the solution.
-      // Thus, elements in those other subsets can be removed from the universe.
-      dlx_element_cover (j->elementInUniverse);
+      context->solution[nb_required + k] = name;
     }
+  }
+
+  DLX_DISPLAY_SOLUTION (context, nb_required + length, context->solution);
+}
 
-    /// Calls \p dlx_universe_search recursively (backtracking), incrementing \p k.
-    solution_found += dlx_universe_search (universe, solutions, k + 1, one_only);
+/// Key of a subset: the sorted list of the indices of the elements of the universe it contains.
+struct subset_key {
+  unsigned long *elements; ///< Sorted indices of the elements contained in the subset.
+  unsigned long length;    ///< Number of elements contained in the subset.
+  unsigned long subset;    ///< Index of the subset.
+  unsigned long rank;      ///< Rank of the subset among identical subsets (in order of definition.)
+  int disabled;            ///< Set if the subset is disabled.
+};
 
-    solutions[k] = 0;
+/// Compares two indices (for qsort).
+static int
+dlx_index_compare (const void *a, const void *b) {
+  unsigned long ia = *(const unsigned long *)a;
+  unsigned long ib = *(const unsigned long *)b;
 
-    for (struct element *j = r->previousElement; j != r; j = j->previousElement)
-      dlx_element_uncover (j->elementInUniverse);
+  return ia < ib ? -1 : ia > ib ? 1 : 0;
+}
 
-    if (solution_found && one_only)
-      break;
-  }
+/// Compares two lists of indices lexicographically.
+static int
+dlx_indices_compare (const unsigned long *a, unsigned long length_a, const unsigned long *b, unsigned long length_b) {
+  for (unsigned long i = 0; i < length_a && i < length_b; i++)
+    if (a[i] != b[i])
+      return a[i] < b[i] ? -1 : 1;
 
-  dlx_element_uncover (c);
+  return length_a < length_b ? -1 : length_a > length_b ? 1 : 0;
+}
 
-  // The universe is fully restored (all elements uncovered).
+/// Compares the key of a subset with a subset given by its state and its sorted list of elements.
+/// Enabled subsets are sorted first.
+static int
+dlx_subset_key_compare_to (const struct subset_key *key, int disabled, const unsigned long *elements, unsigned long length) {
+  if (key->disabled != disabled)
+    return key->disabled < disabled ? -1 : 1;
 
-  return solution_found;
+  return dlx_indices_compare (key->elements, key->length, elements, length);
 }
 
-dlx_solution_displayer
-dlx_displayer_set (Universe universe, dlx_solution_displayer msd, void *data) {
-  dlx_solution_displayer old = universe->solution_displayer;
+/// Compares two keys of subsets (for qsort), identical subsets being sorted in order of definition.
+static int
+dlx_subset_key_compare (const void *a, const void *b) {
+  const struct subset_key *ka = a;
+  const struct subset_key *kb = b;
+  int ret = dlx_subset_key_compare_to (ka, kb->disabled, kb->elements, kb->length);
 
-  universe->solution_displayer = msd;
-  universe->solution_displayer_data = data;
-  return old;
+  return ret ? ret : ka->subset < kb->subset ? -1 : ka->subset > kb->subset ? 1 : 0;
 }
 
-Universe
-dlx_universe_create (void) __attribute__ ((overloadable)) {
-  Universe universe = malloc (sizeof (*universe));
-  universe->head = malloc (sizeof (*universe->head));
+/// Computes the sorted keys of all the subsets of the universe.
+/// @param [in] universe Universe
+/// @return Keys of the subsets, sorted.
+/// @post User must call dlx_subset_keys_free() later.
+static struct subset_key *
+dlx_universe_subset_keys (const struct universe *universe) {
+  const struct links *links = universe->matrix.links;
+  struct subset_key *keys = malloc (universe->nb_subsets * sizeof (*keys));
+
+  for (unsigned long s = 0; s < universe->nb_subsets; s++) {
+    unsigned long first = universe->subsets[s].node;
+    unsigned long elementInSubset = first;
+
+    keys[s].length = 0;
+    do {
+      keys[s].length++;
+      elementInSubset = links[elementInSubset].nextElement;
+    } while (elementInSubset != first);
+
+    keys[s].elements = malloc (keys[s].length * sizeof (*keys[s].elements));
+    keys[s].length = 0;
+    do {
+      keys[s].elements[keys[s].length++] = universe->columns[elementInSubset];
+      elementInSubset = links[elementInSubset].nextElement;
+    } while (elementInSubset != first);
+    qsort (keys[s].elements, keys[s].length, sizeof (*keys[s].elements), dlx_index_compare);
+    keys[s].subset = s;
+    keys[s].disabled = universe->subsets[s].disabled;
+  }
 
-  universe->head->previousElement = universe->head->nextElement = universe->head;
-  universe->head->size = 0;
-  universe->head->name = "|HEAD|";
-  // Other unused components of head are left undefined.
+  qsort (keys, universe->nb_subsets, sizeof (*keys), dlx_subset_key_compare);
 
-  universe->solution = 0;
-  universe->solution_length = 0;
-  universe->uncover_column = 0;
-  universe->uncover_column_length = 0;
-  universe->solution_displayer = 0;
-  universe->solution_displayer_data = 0;
-  universe->unbound = 1; // Unboud universe.
+  for (unsigned long s = 0; s < universe->nb_subsets; s++)
+    keys[s].rank = s && !dlx_subset_key_compare_to (&keys[s], keys[s - 1].disabled, keys[s - 1].elements, keys[s - 1].length) ? keys[s - 1].rank + 1 : 0;
 
-  return universe;
+  return keys;
 }
 
-Universe
-dlx_universe_create (unsigned long nb_elements, const char *elements[]) __attribute__ ((overloadable)) {
-  if (!nb_elements || !elements)
-    return 0;
+/// Releases the keys of subsets.
+static void
+dlx_subset_keys_free (struct subset_key *keys, unsigned long nb_keys) {
+  for (unsigned long s = 0; s < nb_keys; s++)
+    free (keys[s].elements);
+  free (keys);
+}
 
-  /// @overload
-  Universe universe = dlx_universe_create ();
-  universe->unbound = 0; // Bound universe.
+/// Computes the permutation of the subsets induced by a permutation of the elements of the universe.
+/// @param [in] keys Sorted keys of the subsets.
+/// @param [in] nb_keys Number of subsets.
+/// @param [in] permutation Permutation of the elements of the universe.
+/// @param [out] subset_map Permutation of the subsets (can be 0 if only checking.)
+/// @return 1 if the permutation maps every subset on a subset (it is an automorphism of the universe), 0 otherwise.
+///
+/// The n-th of identical subsets is mapped on the n-th of the identical images. Enabled subsets must be mapped on enabled subsets.
+static int
+dlx_permutation_map_subsets (const struct subset_key *keys, unsigned long nb_keys, const unsigned long *permutation, unsigned long *subset_map) {
+  unsigned long *image = 0;
+  unsigned long image_size = 0;
+  int ret = 1;
+
+  for (unsigned long s = 0; ret && s < nb_keys; s++) {
+    if (keys[s].length > image_size)
+      image = realloc (image, (image_size = keys[s].length) * sizeof (*image));
+    for (unsigned long e = 0; e < keys[s].length; e++)
+      image[e] = permutation[keys[s].elements[e]];
+    qsort (image, keys[s].length, sizeof (*image), dlx_index_compare);
+
+    // Binary search of the first subset identical to the image.
+    unsigned long low = 0, high = nb_keys;
+
+    while (low < high) {
+      unsigned long mid = low + (high - low) / 2;
+
+      if (dlx_subset_key_compare_to (&keys[mid], keys[s].disabled, image, keys[s].length) < 0)
+        low = mid + 1;
+      else
+        high = mid;
+    }
 
-  DLX_PRINT ("Elements in universe:");
-  int redo = 0;
+    low += keys[s].rank;
+    if (low < nb_keys && !dlx_subset_key_compare_to (&keys[low], keys[s].disabled, image, keys[s].length) && keys[low].rank == keys[s].rank) {
+      if (subset_map)
+        subset_map[keys[s].subset] = keys[low].subset;
+    } else
+      ret = 0;
+  }
 
-  for (unsigned long i = 0; i < nb_elements; i++) {
-    if (!elements[i] || !*elements[i])
-      continue;
+  free (image);
+  return ret;
+}
 
-    DLX_PRINT (" %s", elements[i]);
-    if (!dlx_head_add_element (universe->head, elements[i])) {
-      DLX_PRINT (" (already exists ==> not added)");
-      redo = 1;
-    }
+/// Releases a group of symmetries.
+static void
+dlx_symmetry_group_free (struct symmetry_group *symmetry) {
+  if (!symmetry)
+    return;
+
+  for (unsigned long g = 0; g < symmetry->group_size; g++) {
+    free (symmetry->group[g]);
+    free (symmetry->subset_map[g]);
   }
+  free (symmetry->group);
+  free (symmetry->subset_map);
+  free (symmetry);
+}
 
-  if (redo) {
-    DLX_PRINT (" =");
-    for (struct element *element = universe->head->nextElement; element != universe->head;
-         element = element->nextElement)
-      DLX_PRINT (" %s", element->name);
+/// Computes the group of symmetries of the universe before a search.
+/// @param [in] universe Universe
+/// @param [in] trace Trace execution on standard error terminal if set.
+/// @return Group of symmetries.
+/// @post User must call dlx_symmetry_group_free() later.
+///
+/// The group is generated by the declared permutations, and restricted to the permutations that leave the set of elements
+/// already covered (by required subsets) and the set of disabled elements unchanged, so that the remaining problem is mapped onto itself.
+/// An element of the universe left unchanged by all the permutations is chosen, if any, as the root of the search.
+static struct symmetry_group *
+dlx_universe_symmetry_group (const struct universe *universe, int trace) {
+  const struct symmetry *declared = universe->symmetry;
+  const struct links *links = universe->matrix.links;
+  struct symmetry_group *symmetry = calloc (1, sizeof (*symmetry));
+  const struct {
+    int trace;
+  } tracer = { trace };
+
+  unsigned long n = universe->nb_elements;
+  char *uncovered = calloc (n + 1, sizeof (*uncovered));
+
+  for (unsigned long element = links[HEAD].nextElement; element != HEAD; element = links[element].nextElement)
+    uncovered[universe->columns[element]] = 1;
+  for (unsigned long e = 0; e < n; e++)
+    if (universe->elements[e].disabled)
+      uncovered[e] = 2;
+
+  // Closure of the generators (breadth-first), starting with the identity.
+  symmetry->group = malloc (sizeof (*symmetry->group));
+  symmetry->group[0] = malloc ((n + 1) * sizeof (**symmetry->group));
+  for (unsigned long e = 0; e < n; e++)
+    symmetry->group[0][e] = e;
+  symmetry->group_size = 1;
+
+  int closed = 1;
+
+  for (unsigned long g = 0; closed && g < symmetry->group_size; g++)
+    for (unsigned long i = 0; closed && i < declared->nb_generators; i++) {
+      unsigned long *p = malloc ((n + 1) * sizeof (*p));
+
+      for (unsigned long e = 0; e < n; e++)
+        p[e] = declared->generators[i][symmetry->group[g][e]];
+
+      unsigned long h;
+
+      for (h = 0; h < symmetry->group_size && memcmp (p, symmetry->group[h], n * sizeof (*p)); h++)
+        /**/;
+
+      if (h < symmetry->group_size)
+        free (p);
+      else if (symmetry->group_size == DLX_SYMMETRY_GROUP_MAX_SIZE) {
+        free (p);
+        closed = 0;
+      } else {
+        symmetry->group = realloc (symmetry->group, (symmetry->group_size + 1) * sizeof (*symmetry->group));
+        symmetry->group[symmetry->group_size++] = p;
+      }
+    }
+
+  // A part of a group is not a group: canonical solutions and their numbers of images would be wrong. The symmetries are ignored.
+  if (!closed) {
+    DLX_PRINT (&tracer, "Symmetries ignored: they generate a group of more than %i permutations.\n", DLX_SYMMETRY_GROUP_MAX_SIZE);
+    for (unsigned long g = 1; g < symmetry->group_size; g++)
+      free (symmetry->group[g]);
+    symmetry->group_size = 1;
   }
 
-  DLX_PRINT ("\n");
+  // Keeps the permutations that leave the elements still to be covered globally unchanged.
+  unsigned long size = 0;
 
-  return universe;
-}
+  for (unsigned long g = 0; g < symmetry->group_size; g++) {
+    unsigned long e;
 
-Universe
-dlx_universe_create (const char *elements, const char *separators) __attribute__ ((overloadable)) {
-  if (!elements)
-    return 0;
+    for (e = 0; e < n && uncovered[e] == uncovered[symmetry->group[g][e]]; e++)
+      /**/;
 
-  char *sccpy;
-  char *saveptr;
-  unsigned long nb_cols;
+    if (e < n)
+      free (symmetry->group[g]);
+    else
+      symmetry->group[size++] = symmetry->group[g];
+  }
+  symmetry->group_size = size;
+
+  // Action of the group on subsets.
+  struct subset_key *keys = dlx_universe_subset_keys (universe);
+
+  symmetry->subset_map = malloc (symmetry->group_size * sizeof (*symmetry->subset_map));
+  size = 0;
+  for (unsigned long g = 0; g < symmetry->group_size; g++) {
+    symmetry->subset_map[size] = malloc ((universe->nb_subsets + 1) * sizeof (**symmetry->subset_map));
+    if (dlx_permutation_map_subsets (keys, universe->nb_subsets, symmetry->group[g], symmetry->subset_map[size]))
+      symmetry->group[size++] = symmetry->group[g];
+    else {
+      // A subset defined after the declaration of the symmetry breaks it.
+      DLX_PRINT (&tracer, "Symmetry ignored: it does not map subsets on subsets anymore.\n");
+      free (symmetry->group[g]);
+      free (symmetry->subset_map[size]);
+    }
+  }
+  symmetry->group_size = size;
 
-  sccpy = strdup (elements);
-  nb_cols = 0;
-  for (char *c = sccpy; strtok_r (c, separators, &saveptr); c = 0)
-    nb_cols++;
-  free (sccpy);
+  dlx_subset_keys_free (keys, universe->nb_subsets);
 
-  if (!nb_cols)
-    return 0;
+  // Chooses the root among the elements left unchanged by the whole group.
+  symmetry->root = HEAD;
+  for (unsigned long element = links[HEAD].nextElement; element != HEAD; element = links[element].nextElement) {
+    unsigned long g;
 
-  const char *cols[nb_cols];
+    for (g = 0; g < symmetry->group_size && symmetry->group[g][universe->columns[element]] == universe->columns[element]; g++)
+      /**/;
+
+    if (g == symmetry->group_size && !universe->elements[universe->columns[element]].disabled &&
+        (symmetry->root == HEAD || universe->matrix.size[universe->columns[element]] < universe->matrix.size[universe->columns[symmetry->root]]))
+      symmetry->root = element;
+  }
+
+  free (uncovered);
+
+  DLX_PRINT (&tracer, "Symmetry group of order %lu%s%s.\n", symmetry->group_size, symmetry->root != HEAD ? ", search rooted at element " : "",
+             symmetry->root != HEAD ? universe->elements[universe->columns[symmetry->root]].name : "");
+
+  return symmetry;
+}
+
+/// Marks the group of symmetries of the universe as out of date, after a modification of the universe.
+static void
+dlx_universe_symmetry_invalidate (Universe universe) {
+  if (universe->symmetry) {
+    dlx_symmetry_group_free (universe->symmetry->group);
+    universe->symmetry->group = 0;
+  }
+}
+
+/// Checks whether a subset tried at the first level of the search is the representative of its orbit.
+/// @param [in] context Search context
+/// @param [in] subset Index of the subset
+/// @return 1 if the subset is the smallest of its orbit, 0 otherwise.
+/// @post The number of subsets in the orbit is kept for further counting of solutions.
+static int
+dlx_search_select_root_subset (SearchContext context, unsigned long subset) {
+  const struct symmetry_group *symmetry = context->symmetry;
+
+  for (unsigned long g = 0; g < symmetry->group_size; g++)
+    if ((context->image[g] = symmetry->subset_map[g][subset]) < subset)
+      return 0;
+
+  qsort (context->image, symmetry->group_size, sizeof (*context->image), dlx_index_compare);
+  context->root_weight = 0;
+  for (unsigned long g = 0; g < symmetry->group_size; g++)
+    if (!g || context->image[g] != context->image[g - 1])
+      context->root_weight++;
+  context->root_subset = subset;
+
+  return 1;
+}
+
+/// Checks whether a solution is canonical, that is the smallest among its images by the group of symmetries.
+/// @param [in] context Search context
+/// @param [in] length Number of subsets in the solution.
+/// @param [in] multiplicity Number of solutions of the model before identical subsets were merged, represented by the solution.
+/// @return 1 if the solution is canonical, 0 otherwise.
+/// @post The number of solutions, symmetric images included, is updated.
+///
+/// If the search is rooted, only the permutations that leave the subset tried at the first level unchanged are considered,
+/// since images by other permutations are not explored.
+static int
+dlx_search_solution_is_canonical (SearchContext context, unsigned long length, unsigned long multiplicity) {
+  const struct symmetry_group *symmetry = context->symmetry;
+  int rooted = symmetry->root != HEAD;
+
+  context->nb_solutions_total += (rooted ? context->root_weight : 1) * multiplicity;
+
+  for (unsigned long k = 0; k < length; k++)
+    context->canonical[k] = dlx_universe_subset_of (context->universe, context->solutions[k]);
+  qsort (context->canonical, length, sizeof (*context->canonical), dlx_index_compare);
+
+  for (unsigned long g = 1; g < symmetry->group_size; g++) {
+    if (rooted && symmetry->subset_map[g][context->root_subset] != context->root_subset)
+      continue;
+
+    for (unsigned long k = 0; k < length; k++)
+      context->image[k] = symmetry->subset_map[g][context->canonical[k]];
+    qsort (context->image, length, sizeof (*context->image), dlx_index_compare);
+
+    if (dlx_indices_compare (context->image, length, context->canonical, length) < 0)
+      return 0;
+  }
+
+  return 1;
+}
+
+/// Counts a solution found by the search.
+/// @param [in] context Search context
+/// @param [in] length Number of subsets chosen by the search in the solution.
+/// @return 1 if the solution is kept, 0 otherwise (with symmetries, the solution is not canonical.)
+/// @post The numbers of solutions, with and without symmetric images and merged identical subsets, are updated.
+///
+/// A solution made of merged subsets stands for the product of their multiplicities solutions of the model before merge
+/// (subsets required in solutions excluded, since a single one of identical subsets is required.)
+static int
+dlx_search_solution_count (SearchContext context, unsigned long length) {
+  const struct universe *universe = context->universe;
+  unsigned long multiplicity = 1;
+
+  for (unsigned long k = 0; universe->nb_duplicates && k < length; k++)
+    multiplicity *= universe->subsets[dlx_universe_subset_of (universe, context->solutions[k])].multiplicity;
+
+  // With symmetries, only canonical solutions are kept.
+  if (context->symmetry && context->symmetry->group_size > 1) {
+    if (!dlx_search_solution_is_canonical (context, length, multiplicity))
+      return 0;
+  } else
+    context->nb_solutions_total += multiplicity;
+
+  context->nb_solutions++;
+  return 1;
+}
+
+/// Gets the order of subsets applied by the search of a search context.
+/// @param [in] context Search context
+/// @return Order of subsets.
+///
+/// The order of failures depends on the history of the search context and can not be reproduced:
+/// searches which save or resume checkpoints, and jobs, try subsets in order of definition instead.
+static enum dlx_subset_order
+dlx_search_subset_order (SearchContext context) {
+  // In automatic mode, the order chosen by the automatic selection applies.
+  enum dlx_subset_order order = context->engine == DLX_ENGINE_AUTO && context->choice.nb_workers ? context->choice.subset_order : context->subset_order;
+
+  if (order == DLX_ORDER_FAILURES &&
+      (context->checkpoint_file || context->resume_length || context->prefix_length || context->split_depth != ULONG_MAX || context->result))
+    return DLX_ORDER_DEFINITION;
+
+  return order;
+}
+
+/// Gets the propagation setting applied by the search of a search context.
+/// @param [in] context Search context
+/// @return 1 if subsets are forced and dead ends detected after each choice, 0 otherwise.
+static int
+dlx_search_propagation (SearchContext context) {
+  // In automatic mode, the propagation chosen by the automatic selection applies.
+  return context->engine == DLX_ENGINE_AUTO && context->choice.nb_workers ? context->choice.propagation : context->propagation;
+}
+
+/// Computes a fingerprint of the model searched by a search context.
+/// @param [in] context Search context
+/// @return Hash of the elements, subsets, required subsets, symmetries of the universe and of the order of subsets.
+///
+/// A checkpoint can only be resumed on a search context with the same fingerprint.
+/// The order of subsets is part of it since it sets the order of the branches skipped when resuming.
+static unsigned long long
+dlx_search_fingerprint (SearchContext context) {
+  const struct universe *universe = context->universe;
+  unsigned long long hash = 14695981039346656037ULL; // FNV-1a
+
+#define DLX_FINGERPRINT_ADD(value) (hash = (hash ^ (unsigned long long) (value)) * 1099511628211ULL)
+  DLX_FINGERPRINT_ADD (universe->nb_elements);
+  for (unsigned long i = 0; i < universe->nb_elements; i++) {
+    for (const char *c = universe->elements[i].name; *c; c++)
+      DLX_FINGERPRINT_ADD (*c);
+    if (universe->elements[i].disabled)
+      DLX_FINGERPRINT_ADD (ULONG_MAX - 1);
+  }
+  DLX_FINGERPRINT_ADD (universe->nb_subsets);
+  for (unsigned long s = 0; s < universe->nb_subsets; s++) {
+    unsigned long r = universe->subsets[s].node;
+    unsigned long j = r;
+
+    do {
+      DLX_FINGERPRINT_ADD (universe->columns[j]);
+      j = universe->matrix.links[j].nextElement;
+    } while (j != r);
+    DLX_FINGERPRINT_ADD (universe->subsets[s].disabled ? ULONG_MAX - 1 : ULONG_MAX);
+    if (universe->subsets[s].multiplicity > 1)
+      DLX_FINGERPRINT_ADD (universe->subsets[s].multiplicity);
+  }
+  DLX_FINGERPRINT_ADD (universe->nb_required_subsets);
+  for (unsigned long i = 0; i < universe->nb_required_subsets; i++)
+    DLX_FINGERPRINT_ADD (universe->required_subsets[i]);
+  DLX_FINGERPRINT_ADD (context->symmetry ? context->symmetry->group_size : 1);
+  if (dlx_search_propagation (context))
+    DLX_FINGERPRINT_ADD (ULONG_MAX - 2);
+  if (context->max_length)
+    DLX_FINGERPRINT_ADD (context->max_length);
+
+  // Subsets are never tried in order of failures when saving or resuming the search.
+  enum dlx_subset_order order = context->subset_order == DLX_ORDER_FAILURES ? DLX_ORDER_DEFINITION : context->subset_order;
+
+  if (order != DLX_ORDER_DEFINITION)
+    DLX_FINGERPRINT_ADD (ULONG_MAX - 3 - order);
+  for (unsigned long s = 0; order == DLX_ORDER_PRIORITY && s < universe->nb_subsets; s++) {
+    unsigned long long priority;
+
+    memcpy (&priority, &universe->subsets[s].priority, sizeof (priority));
+    DLX_FINGERPRINT_ADD (priority);
+  }
+#undef DLX_FINGERPRINT_ADD
+
+  return hash;
+}
+
+/// Gets the name of the file of a job.
+/// @param [in] prefix Prefix of the names of the job files
+/// @param [in] job Index of the job
+/// @param [in] suffix Suffix of the name (".job" or ".result")
+/// @return Name of the file, to be released by the caller.
+static char *
+dlx_job_filename (const char *prefix, unsigned long job, const char *suffix) {
+  size_t length = strlen (prefix) + 3 * sizeof (job) + strlen (suffix) + 2;
+  char *filename = malloc (length);
+
+  snprintf (filename, length, "%s.%lu%s", prefix, job, suffix);
+  return filename;
+}
+
+/// Saves the frontier of the search in a file, either as a checkpoint or as a job.
+/// @param [in] context Search context
+/// @param [in] filename Name of the file
+/// @param [in] k Depth of the search, or ULONG_MAX if the search is completed.
+/// @param [in] job If set, the subtree of the current node is saved as a job, with its own counters: the \p k levels above it are fixed.
+/// @return 1 if saved successfully, 0 otherwise.
+///
+/// The frontier is the subset chosen at each of the \p k levels above the current node, and the counters of the search.
+/// Branches before the chosen subsets have been fully explored, the current node not yet.
+/// The file is replaced atomically, so that a previous checkpoint is kept if the process is killed meanwhile.
+static int
+dlx_search_frontier_write (SearchContext context, const char *filename, unsigned long k, int job) {
+  int complete = k == ULONG_MAX;
+  size_t length = strlen (filename);
+  char temporary[length + sizeof (".tmp")];
+
+  strcpy (temporary, filename);
+  strcpy (temporary + length, ".tmp");
+
+  FILE *file = fopen (temporary, "w");
+
+  if (!file) {
+    DLX_PRINT (context, "Checkpoint: %s can not be written.\n", temporary);
+    return 0;
+  }
+
+  // Nodes on the path to the current node will be visited again when resuming (subsets forced by propagation are not nodes.)
+  fprintf (file, "DLX checkpoint %i\n", DLX_CHECKPOINT_VERSION);
+  fprintf (file, "fingerprint %llx\n", dlx_search_fingerprint (context));
+  fprintf (file, "complete %i\n", complete);
+  fprintf (file, "nodes %lu\n", job ? 0 : complete ? context->nb_nodes : context->nb_nodes - (k + 1 - context->nb_path_forced));
+  fprintf (file, "solutions %lu\n", job ? 0 : context->nb_solutions);
+  fprintf (file, "total %lu\n", job ? 0 : context->nb_solutions_total);
+  fprintf (file, "prefix %lu\n", job ? k : complete ? 0 : context->prefix_length);
+  fprintf (file, "depth %lu\n", complete ? 0 : k);
+  fprintf (file, "path");
+  for (unsigned long i = 0; !complete && i < k; i++)
+    fprintf (file, " %lu", dlx_universe_subset_of (context->universe, context->solutions[i]));
+  fprintf (file, "\n");
+
+  if (fclose (file) || rename (temporary, filename)) {
+    DLX_PRINT (context, "Checkpoint: %s can not be written.\n", filename);
+    remove (temporary);
+    return 0;
+  }
+
+  return 1;
+}
+
+/// Gets the number of page faults of the calling thread so far (of the process where the system does not count them per thread.)
+/// @return Number of minor and major page faults.
+static unsigned long
+dlx_memory_faults (void) {
+  struct rusage usage;
+
+#ifdef RUSAGE_THREAD
+  if (getrusage (RUSAGE_THREAD, &usage))
+#else
+  if (getrusage (RUSAGE_SELF, &usage))
+#endif
+    return 0;
+
+  return (unsigned long)usage.ru_minflt + (unsigned long)usage.ru_majflt;
+}
+
+/// Gets the time elapsed since an arbitrary point in the past.
+/// @return Time, in milliseconds.
+static double
+dlx_clock_milliseconds (void) {
+  struct timespec now;
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e3 + now.tv_nsec * 1e-6;
+}
+
+/// Schedules the next run of the periodic tasks of a search (checkpoints, progress reports).
+/// @param [in] context Search context
+static void
+dlx_search_schedule (SearchContext context) {
+  context->next_poll = ULONG_MAX;
+
+  if (context->checkpoint_interval && context->next_checkpoint < context->next_poll)
+    context->next_poll = context->next_checkpoint;
+  if (context->progress_reporter && context->progress_interval && context->next_progress < context->next_poll)
+    context->next_poll = context->next_progress;
+  if (context->progress_reporter && context->progress_milliseconds && context->nb_nodes + DLX_PROGRESS_POLL_NODES < context->next_poll)
+    context->next_poll = context->nb_nodes + DLX_PROGRESS_POLL_NODES;
+  if (context->node_limit < context->next_poll)
+    context->next_poll = context->node_limit;
+}
+
+/// Runs the periodic tasks of a search which are due.
+/// @param [in] context Search context
+/// @param [in] k Depth of the search
+static void
+dlx_search_poll (SearchContext context, unsigned long k) {
+  if (context->nb_nodes >= context->node_limit) {
+    context->stop_requested = 1;
+    context->checkpoint_requested = 1;
+  }
+
+  if (context->checkpoint_interval && context->nb_nodes >= context->next_checkpoint) {
+    context->next_checkpoint = context->nb_nodes + context->checkpoint_interval;
+    context->checkpoint_requested = 1;
+  }
+
+  if (context->progress_reporter) {
+    int due = context->progress_interval && context->nb_nodes >= context->next_progress;
+    double now = context->progress_milliseconds ? dlx_clock_milliseconds () : 0;
+
+    if (context->progress_milliseconds && now >= context->next_progress_time)
+      due = 1;
+
+    if (due) {
+      struct dlx_search_progress progress;
+
+      progress.depth = k;
+      progress.nodes = context->nb_nodes;
+      progress.solutions = context->nb_solutions;
+      progress.levels = k < context->progress_levels ? k : context->progress_levels;
+      progress.position = context->progress_position;
+      progress.branches = context->progress_branches;
+
+      // Estimated fraction of the search tree explored (see Knuth, The Art of Computer Programming, Volume 4B, Dancing Links):
+      // the subtree of each branch at a level is assumed to weigh the same.
+      progress.fraction = 0;
+      for (unsigned long level = progress.levels; level-- > 0;)
+        progress.fraction = (context->progress_position[level] + progress.fraction) / context->progress_branches[level];
+
+      context->progress_reporter (context, &progress, context->progress_data);
+
+      if (context->progress_interval)
+        context->next_progress = context->nb_nodes + context->progress_interval;
+      if (context->progress_milliseconds)
+        context->next_progress_time = now + context->progress_milliseconds;
+    }
+  }
+
+  dlx_search_schedule (context);
+}
+
+/// Checks whether the solution would exceed the maximal length of solutions.
+/// @param [in] context Search context
+/// @param [in] k Number of subsets already in the solution (required subsets excluded.)
+/// @return 1 if the elements left can not be covered within the maximal length, 0 otherwise.
+///
+/// Covering the elements left needs at least their number divided by the number of elements of the longest subset.
+static int
+dlx_search_length_exceeded (SearchContext context, unsigned long k) {
+  const struct links *links = context->matrix.links;
+  unsigned long max_subset_length = context->universe->max_subset_length;
+  unsigned long left = 0;
+
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement)
+    left++;
+
+  if (!max_subset_length)
+    return left > 0;
+
+  return context->universe->nb_required_subsets + k + (left + max_subset_length - 1) / max_subset_length > context->max_length;
+}
+
+/// Computes a lower bound of the cost of the subsets still to be added to the solution.
+/// @param [in] context Search context
+/// @return Lower bound of the cost (HUGE_VAL if an element is left in no subset.)
+///
+/// The weight of a subset is shared equally by its elements: the cost of the subsets covering the elements still to be covered
+/// is at least the sum, over these elements, of the cheapest share among the subsets containing them (weights are not negative.)
+static double
+dlx_search_lower_bound (SearchContext context) {
+  const struct links *links = context->matrix.links;
+  double bound = 0;
+
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement) {
+    double cheapest = HUGE_VAL;
+
+    for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c;
+         r = links[r].elementInNextSubsetContainingThisElementOfUniverse)
+      if (context->share[r] < cheapest)
+        cheapest = context->share[r];
+    bound += cheapest;
+  }
+
+  return bound;
+}
+
+/// Notifies the event handler of a search context of an event of the search.
+/// @param [in] context Search context
+/// @param [in] event Event
+/// @param [in] depth Position of the subset in the solution (from 0, required subsets first), or length of the solution found.
+/// @param [in] subset Index of the subset added or removed (ULONG_MAX for a solution.)
+static void
+dlx_search_notify (SearchContext context, enum dlx_search_event event, unsigned long depth, unsigned long subset) {
+  const char *name = subset == ULONG_MAX ? 0 : context->universe->subsets[subset].name;
+
+  context->event_handler (context, event, depth, subset, name, context->event_data);
+}
+
+/// Toggles the elements of a subset in the hash of the elements covered by the current path of the search.
+/// @param [in] context Search context
+/// @param [in] r Element of the subset in the node storage
+///
+/// Used when the subset is covered, and again when it is uncovered.
+static void
+dlx_nogood_key_toggle (SearchContext context, unsigned long r) {
+  struct nogood_store *store = context->nogoods;
+  unsigned long subset = dlx_universe_subset_of (context->universe, r);
+
+  store->key[0] ^= store->subset_keys[subset][0];
+  store->key[1] ^= store->subset_keys[subset][1];
+}
+
+/// Propagates a choice of the search: subsets containing the only subset left for an element are forced into the solution.
+/// @param [in] context Search context
+/// @param [in] k Number of subsets already in the solution.
+/// @param [out] dead_end Set if an element is left in no subset: the choice leads to no solution.
+/// @return Number of subsets forced into the solution (at levels \p k and beyond).
+/// @post User must call dlx_search_unpropagate() later, even on dead end.
+///
+/// Forced subsets are taken in the order the search would have chosen them (the first element with a single subset left),
+/// so that solutions are found in the same order as without propagation. The forced subsets are the trail of the propagation.
+static unsigned long
+dlx_search_propagate (SearchContext context, unsigned long k, int *dead_end) {
+  struct matrix *matrix = &context->matrix;
+  struct links *links = matrix->links;
+  const unsigned long *columns = context->universe->columns;
+  const struct column *elements = context->universe->elements;
+  unsigned long forced = 0;
+
+  *dead_end = 0;
+  for (;;) {
+    unsigned long c = HEAD;
+
+    for (unsigned long j = links[HEAD].nextElement; j != HEAD && !*dead_end; j = links[j].nextElement)
+      if (!matrix->size[columns[j]])
+        *dead_end = 1;
+      else if (matrix->size[columns[j]] == 1 && c == HEAD)
+        c = j;
+
+    if (*dead_end) {
+      context->nb_dead_ends++;
+      break;
+    }
+    if (c == HEAD)
+      break;
+
+    unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse;
+
+    context->solutions[k + forced] = r;
+    if (context->path_cost)
+      context->path_cost[k + forced + 1] =
+          context->path_cost[k + forced] + context->universe->subsets[dlx_universe_subset_of (context->universe, r)].weight;
+    if (k + forced < context->progress_levels) {
+      context->progress_position[k + forced] = 0;
+      context->progress_branches[k + forced] = 1;
+    }
+
+    dlx_element_cover (matrix, columns, c);
+    for (unsigned long j = links[r].nextElement; j != r; j = links[j].nextElement)
+      dlx_element_cover (matrix, columns, elements[columns[j]].node);
+    if (context->nogoods_active)
+      dlx_nogood_key_toggle (context, r);
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_PUSH, context->universe->nb_required_subsets + k + forced, dlx_universe_subset_of (context->universe, r));
+    forced++;
+  }
+
+  context->nb_forced += forced;
+  context->nb_path_forced += forced;
+
+  return forced;
+}
+
+/// Releases the subsets forced by dlx_search_propagate(), in reverse order.
+/// @param [in] context Search context
+/// @param [in] k Number of subsets in the solution before propagation.
+/// @param [in] forced Number of forced subsets.
+static void
+dlx_search_unpropagate (SearchContext context, unsigned long k, unsigned long forced) {
+  struct matrix *matrix = &context->matrix;
+  struct links *links = matrix->links;
+  const unsigned long *columns = context->universe->columns;
+  const struct column *elements = context->universe->elements;
+
+  context->nb_path_forced -= forced;
+  while (forced--) {
+    unsigned long r = context->solutions[k + forced];
+
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_POP, context->universe->nb_required_subsets + k + forced, dlx_universe_subset_of (context->universe, r));
+    if (context->nogoods_active)
+      dlx_nogood_key_toggle (context, r);
+    for (unsigned long j = links[r].previousElement; j != r; j = links[j].previousElement)
+      dlx_element_uncover (matrix, columns, elements[columns[j]].node);
+    dlx_element_uncover (matrix, columns, elements[columns[r]].node);
+  }
+}
+
+/// Mixes the bits of a number (finalizer of the splitmix64 generator.)
+/// @param [in] z Number
+/// @return Mixed number.
+static unsigned long long
+dlx_mix (unsigned long long z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/// Prepares the store of nogoods of a search context for a search.
+/// @param [in] context Search context
+///
+/// The hashes of the elements of the subsets are computed at the first search.
+static void
+dlx_nogoods_prepare (SearchContext context) {
+  const struct universe *universe = context->universe;
+  const struct links *links = context->matrix.links;
+  struct nogood_store *store = context->nogoods;
+
+  if (!store->subset_keys) {
+    store->subset_keys = calloc (universe->nb_subsets + 1, sizeof (*store->subset_keys));
+    for (unsigned long s = 0; s < universe->nb_subsets; s++) {
+      unsigned long first = universe->subsets[s].node, j = first;
+
+      do {
+        store->subset_keys[s][0] ^= dlx_mix (2 * universe->columns[j] + 1);
+        store->subset_keys[s][1] ^= dlx_mix (2 * universe->columns[j] + 2);
+        j = links[j].nextElement;
+      } while (j != first);
+    }
+  }
+  store->key[0] = 0;
+  store->key[1] = 1; // The hash of no covered element is not the one of an empty slot.
+}
+
+/// Looks for a nogood in the store of nogoods.
+/// @param [in] store Store of nogoods
+/// @param [in] key Hash of the set of covered elements.
+/// @return 1 if the set of covered elements is a nogood, 0 otherwise.
+static int
+dlx_nogood_find (const struct nogood_store *store, const unsigned long long *key) {
+  unsigned long long (*bucket)[2] = store->slots + (key[0] & (store->nb_buckets - 1)) * DLX_NOGOOD_BUCKET;
+
+  for (unsigned long i = 0; i < DLX_NOGOOD_BUCKET; i++)
+    if (bucket[i][0] == key[0] && bucket[i][1] == key[1])
+      return 1;
+
+  return 0;
+}
+
+/// Records a nogood in the store of nogoods of a search context.
+/// @param [in] context Search context
+/// @param [in] key Hash of the set of covered elements.
+///
+/// The nogood takes an empty slot of its bucket, or replaces one of the nogoods of the bucket if it is full.
+static void
+dlx_nogood_record (SearchContext context, const unsigned long long *key) {
+  struct nogood_store *store = context->nogoods;
+  unsigned long long (*bucket)[2] = store->slots + (key[0] & (store->nb_buckets - 1)) * DLX_NOGOOD_BUCKET;
+  unsigned long i;
+
+  for (i = 0; i < DLX_NOGOOD_BUCKET && (bucket[i][0] || bucket[i][1]); i++)
+    /**/;
+
+  if (i < DLX_NOGOOD_BUCKET)
+    context->nogood_statistics.stored++;
+  else {
+    i = key[1] % DLX_NOGOOD_BUCKET;
+    context->nogood_statistics.replaced++;
+  }
+  bucket[i][0] = key[0];
+  bucket[i][1] = key[1];
+  context->nogood_statistics.recorded++;
+}
+
+/// Recursive function to search for solutions.
+/// @param [in] context Search context
+/// @param [in] k Depth of search
+/// @param [in] one_only If set, searches for the first solution only.
+/// @return Number of solutions found.
+static unsigned long
+dlx_search (SearchContext context, unsigned long k, int one_only) {
+  struct matrix *matrix = &context->matrix;
+  struct links *links = matrix->links;
+  const unsigned long *columns = context->universe->columns;
+  const struct column *elements = context->universe->elements;
+
+  context->nb_nodes++;
+
+  // When resuming, the node of the frontier is reached: the search goes on normally from here.
+  if (k == context->resume_length)
+    context->resume_length = 0;
+
+  // Periodic tasks (checkpoints, progress reports) are only polled for when they are due.
+  if (context->nb_nodes == context->next_poll)
+    dlx_search_poll (context, k);
+
+  // The frontier of the search is saved periodically or on request (possibly from a signal handler.)
+  // It is not saved before the node of the frontier is reached again when resuming, since branches above it have already been explored.
+  if (context->checkpoint_requested && !context->resume_length) {
+    context->checkpoint_requested = 0;
+    if (context->checkpoint_file)
+      dlx_search_frontier_write (context, context->checkpoint_file, k, 0);
+    if (context->stop_requested) {
+      context->interrupted = 1;
+      return 0;
+    }
+  }
+
+  // When the search is split, the nodes at the depth of the split, and the solutions above it, are saved as jobs instead of being explored.
+  // (Subsets forced by propagation may lead beyond the depth of the split at once.)
+  if (k >= context->split_depth || (context->split_depth != ULONG_MAX && links[HEAD].nextElement == HEAD)) {
+    char *filename = dlx_job_filename (context->split_name, context->nb_jobs, ".job");
+
+    context->nb_jobs += dlx_search_frontier_write (context, filename, k, 1);
+    free (filename);
+    return 0;
+  }
+
+  // If there is no more element in the universe, this means all elements have been covered successfully.
+  // We have found a solution that we can display.
+  if (links[HEAD].nextElement == HEAD) {
+    // Subsets forced by propagation may have led beyond the maximal length at once.
+    if (context->max_length && context->universe->nb_required_subsets + k > context->max_length)
+      return 0;
+
+    // When searching for the solution of minimal cost, the solution is kept if it is the best one so far.
+    if (context->path_cost) {
+      if (context->path_cost[k] < context->best_cost) {
+        context->best_cost = context->path_cost[k];
+        context->best_length = k;
+        memcpy (context->best, context->solutions, k * sizeof (*context->best));
+        DLX_PRINT (context, "Solution of cost %g found.\n", context->best_cost);
+        if (context->event_handler)
+          dlx_search_notify (context, DLX_EVENT_SOLUTION, context->universe->nb_required_subsets + k, ULONG_MAX);
+      }
+      return 0;
+    }
+
+    if (!dlx_search_solution_count (context, k))
+      return 0;
+
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_SOLUTION, context->universe->nb_required_subsets + k, ULONG_MAX);
+    dlx_search_display_solution (context, k);
+    return 1;
+  }
+
+  // Otherwise, we search for an exact cover search: a group of subsets such that the union of them
+  // contains all the elements of the universe and any intersection between two of them is empty.
+
+  // When the length of solutions is limited, branches which would need too many subsets to cover the elements left are pruned.
+  if (context->max_length && dlx_search_length_exceeded (context, k))
+    return 0;
+
+  // When searching for the solution of minimal cost, branches which can not improve the best solution found so far are pruned.
+  if (context->path_cost && context->best_cost < HUGE_VAL && context->path_cost[k] + dlx_search_lower_bound (context) >= context->best_cost)
+    return 0;
+
+  // With nogoods, the subproblems already found to have no solution are pruned.
+  // (The hash is copied, since it is updated by the subsets covered below this node.)
+  unsigned long long key[2] = {0, 0};
+
+  if (context->nogoods_active) {
+    key[0] = context->nogoods->key[0];
+    key[1] = context->nogoods->key[1];
+    context->nogood_statistics.lookups++;
+    if (dlx_nogood_find (context->nogoods, key)) {
+      context->nogood_statistics.hits++;
+      return 0;
+    }
+  }
+
+  unsigned long solution_found = 0;
+
+  // We peek an element deterministically (all elements will have been peeked sucessively at last.)
+  // We keep a reference to the uncovered element for further access.
+  // With symmetries, the first level of the search is rooted at an element left unchanged by the whole group.
+  int rooted = k == 0 && context->symmetry && context->symmetry->group_size > 1 && context->symmetry->root != HEAD;
+  unsigned long c = rooted ? context->symmetry->root : dlx_matrix_choose_element (matrix, columns);
+
+  // When resuming, the subsets before the one of the frontier at this level have already been explored.
+  int resuming = k < context->resume_length;
+  int fixed = k < context->prefix_length; // Only the subset of the frontier is tried at the levels fixed by a job.
+  unsigned long resume_subset = resuming ? context->resume_path[k] : 0;
+
+  // We can remove this element from the universe, since we will retain one of the subsets containig it in the solution
+  // and we won't have to consider this element anymore.
+  dlx_element_cover (matrix, columns, c);
+
+  // One and only one of the subsets containing this element will have to be included in the solution.
+  // One after the other, we try to keep each subset containing the element in the solution,
+  // one after the other, nondeterministically.
+  unsigned long position = 0;
+
+  for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c;
+       r = links[r].elementInNextSubsetContainingThisElementOfUniverse, position++) {
+    if (resuming) {
+      if (dlx_universe_subset_of (context->universe, r) != resume_subset)
+        continue;
+      resuming = 0;
+    }
+
+    // Symmetric subsets would lead to symmetric solutions: only one subset of each orbit is tried.
+    if (rooted && !dlx_search_select_root_subset (context, dlx_universe_subset_of (context->universe, r)))
+      continue;
+
+    // We consider, as a trial-and-error approach, that the subset containing the element is part of the solution.
+    context->solutions[k] = r;
+    if (context->path_cost)
+      context->path_cost[k + 1] = context->path_cost[k] + context->universe->subsets[dlx_universe_subset_of (context->universe, r)].weight;
+
+    // Branch positions at the top levels are kept for progress reports.
+    if (k < context->progress_levels) {
+      context->progress_position[k] = position;
+      context->progress_branches[k] = matrix->size[columns[c]];
+    }
+
+    // This subset containing the element might also contain other elements which are
+    // de facto included in the solution.
+    for (unsigned long j = links[r].nextElement; j != r; j = links[j].nextElement) {
+      // We won't have to search for a valid element in these columns containing j.
+      // We can therefore remove these columns from the matrix.
+
+      // Furthermore, the solution can not contain other subsets that
+      // contain the same elements, otherwise,
+      // there would be more than one subset containig the same element in the solution.
+      // Thus, elements in those other subsets can be removed from the universe.
+      dlx_element_cover (matrix, columns, elements[columns[j]].node);
+    }
+
+    if (context->nogoods_active)
+      dlx_nogood_key_toggle (context, r);
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_PUSH, context->universe->nb_required_subsets + k, dlx_universe_subset_of (context->universe, r));
+
+    // With propagation, subsets forced by this choice are added at once, and the choice is given up if an element can no longer be covered.
+    int dead_end = 0;
+    unsigned long forced = dlx_search_propagation (context) ? dlx_search_propagate (context, k + 1, &dead_end) : 0;
+
+    /// Calls \p dlx_search recursively (backtracking), incrementing \p k.
+    unsigned long branch_solutions = dead_end ? 0 : dlx_search (context, k + 1 + forced, one_only);
+
+    solution_found += branch_solutions;
+    if (!branch_solutions && context->failures && !context->interrupted)
+      context->failures[dlx_universe_subset_of (context->universe, r)]++;
+
+    dlx_search_unpropagate (context, k + 1, forced);
+
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_POP, context->universe->nb_required_subsets + k, dlx_universe_subset_of (context->universe, r));
+    if (context->nogoods_active)
+      dlx_nogood_key_toggle (context, r);
+
+    for (unsigned long j = links[r].previousElement; j != r; j = links[j].previousElement)
+      dlx_element_uncover (matrix, columns, elements[columns[j]].node);
+
+    if ((solution_found && one_only) || context->interrupted || fixed)
+      break;
+  }
+
+  dlx_element_uncover (matrix, columns, c);
+
+  // The universe is fully restored (all elements uncovered).
+
+  // The set of covered elements is a nogood if none of its branches led to a solution.
+  if (context->nogoods_active && !solution_found && !context->interrupted)
+    dlx_nogood_record (context, key);
+
+  return solution_found;
+}
+
+/// Draws a pseudo-random number (splitmix64 generator).
+/// @param [in] context Search context
+/// @return Number uniformly distributed in [0, 1).
+static double
+dlx_sample_uniform (SearchContext context) {
+  unsigned long long z = dlx_mix (context->random_state += 0x9E3779B97F4A7C15ULL);
+
+  return (double)(z >> 11) / (double)(1ULL << 53);
+}
+
+/// Counts the solutions of the subtree of a node of the search tree, within a budget of nodes.
+/// @param [in] context Search context
+/// @param [in] k Level of the node in the search tree
+/// @param [in] weight Product of the multiplicities of the subsets chosen from the level the count started at.
+/// @param [in,out] budget Number of nodes left to visit.
+/// @param [in,out] target If not 0, solutions are passed (their weight subtracted from \p target) until \p target is negative:
+///                        the search then stops on that solution, left in \p context->solutions.
+/// @param [out] length Number of subsets chosen by the search in the solution where the search stopped.
+/// @return Number of solutions (merged identical subsets included), or -1 if the budget was exhausted.
+static double
+dlx_sample_count (SearchContext context, unsigned long k, double weight, unsigned long *budget, double *target, unsigned long *length) {
+  struct matrix *matrix = &context->matrix;
+  struct links *links = matrix->links;
+  const unsigned long *columns = context->universe->columns;
+  const struct column *elements = context->universe->elements;
+
+  if (!*budget)
+    return -1;
+  --*budget;
+  context->nb_nodes++;
+
+  if (links[HEAD].nextElement == HEAD) {
+    if (target && (*target -= weight) < 0)
+      *length = k;
+    return 1;
+  }
+
+  unsigned long c = dlx_matrix_choose_element (matrix, columns);
+
+  if (!matrix->size[columns[c]])
+    return 0;
+
+  double count = 0;
+
+  dlx_element_cover (matrix, columns, c);
+  for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c; r = links[r].elementInNextSubsetContainingThisElementOfUniverse) {
+    double multiplicity = context->universe->subsets[dlx_universe_subset_of (context->universe, r)].multiplicity;
+
+    context->solutions[k] = r;
+    for (unsigned long j = links[r].nextElement; j != r; j = links[j].nextElement)
+      dlx_element_cover (matrix, columns, elements[columns[j]].node);
+
+    double subtree = dlx_sample_count (context, k + 1, weight * multiplicity, budget, target, length);
+
+    for (unsigned long j = links[r].previousElement; j != r; j = links[j].previousElement)
+      dlx_element_uncover (matrix, columns, elements[columns[j]].node);
+
+    if (subtree < 0) {
+      count = -1;
+      break;
+    }
+    count += multiplicity * subtree;
+    if (target && *target < 0)
+      break;
+  }
+  dlx_element_uncover (matrix, columns, c);
+
+  return count;
+}
+
+/// Probes the search tree at random, from a node down to a solution or a dead end.
+/// @param [in] context Search context
+/// @param [in] k Level of the node in the search tree
+/// @param [in] weight Inverse of the probability to reach the node, times the multiplicities of the subsets chosen above it.
+/// @param [out] length Number of subsets chosen by the search in the solution reached, left in \p context->solutions.
+/// @param [out] exact Set if the subtree of the root of the search tree was counted exactly.
+/// @return Weight of the solution reached (inverse of the probability to reach it, times its multiplicity), 0 if a dead end was reached.
+///
+/// The weights of the probes are unbiased estimates of the number of solutions (Knuth's estimator.)
+static double
+dlx_sample_probe (SearchContext context, unsigned long k, double weight, unsigned long *length, int *exact) {
+  struct matrix *matrix = &context->matrix;
+  struct links *links = matrix->links;
+  const unsigned long *columns = context->universe->columns;
+  const struct column *elements = context->universe->elements;
+
+  if (links[HEAD].nextElement == HEAD) {
+    *length = k;
+    return weight;
+  }
+
+  // Subtrees are counted exactly from the level where counts are expected to fit in the budget: a solution of the subtree is then drawn uniformly.
+  // The level is lowered after a count at that level, and raised after a count exhausting the budget.
+  if (context->sampling_exact_nodes && k >= context->sampling_exact_level) {
+    unsigned long budget = context->sampling_exact_nodes;
+    double count = dlx_sample_count (context, k, 1, &budget, 0, 0);
+
+    if (count >= 0) {
+      if (k == context->sampling_exact_level && k)
+        context->sampling_exact_level--;
+      *exact = k == 0;
+      if (count == 0)
+        return 0;
+
+      double target = dlx_sample_uniform (context) * count;
+
+      budget = ULONG_MAX;
+      *length = ULONG_MAX;
+      dlx_sample_count (context, k, 1, &budget, &target, length);
+      return *length == ULONG_MAX ? 0 : weight * count;
+    }
+    context->sampling_exact_level = k + 1;
+  }
+
+  unsigned long c = dlx_matrix_choose_element (matrix, columns);
+  unsigned long nb_branches = matrix->size[columns[c]];
+
+  if (!nb_branches)
+    return 0;
+
+  context->nb_nodes++;
+
+  unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse;
+
+  for (unsigned long branch = (unsigned long)(dlx_sample_uniform (context) * nb_branches); branch; branch--)
+    r = links[r].elementInNextSubsetContainingThisElementOfUniverse;
+
+  double multiplicity = context->universe->subsets[dlx_universe_subset_of (context->universe, r)].multiplicity;
+
+  dlx_element_cover (matrix, columns, c);
+  context->solutions[k] = r;
+  for (unsigned long j = links[r].nextElement; j != r; j = links[j].nextElement)
+    dlx_element_cover (matrix, columns, elements[columns[j]].node);
+
+  double solution_weight = dlx_sample_probe (context, k + 1, weight * nb_branches * multiplicity, length, exact);
+
+  for (unsigned long j = links[r].previousElement; j != r; j = links[j].previousElement)
+    dlx_element_uncover (matrix, columns, elements[columns[j]].node);
+  dlx_element_uncover (matrix, columns, c);
+
+  return solution_weight;
+}
+
+/// Item of the dancing cells search engine (an element of the universe.)
+struct cell_item {
+  unsigned long start;    ///< Position in \p set of the first node of the item.
+  unsigned long size;     ///< Number of active options containing the item.
+  unsigned long rank;     ///< Rank of the item among the elements to be covered, for ties when an item is chosen.
+  unsigned long position; ///< Position of the item in \p active (ULONG_MAX if the item need not be covered.)
+};
+
+/// Node of the dancing cells search engine (an element of a subset.)
+struct cell_node {
+  unsigned long item;     ///< Item of the node.
+  unsigned long location; ///< Position of the node in \p set.
+  unsigned long option;   ///< Option of the node.
+};
+
+/// Sparse sets of the dancing cells search engine.
+///
+/// Options (the subsets left by the subsets required in solutions) are stored as consecutive nodes, one per element of the option.
+/// Items (the elements of the universe) are stored as sets of nodes, consecutive in \p set: the first \p size nodes
+/// from \p start are the nodes of the options still active for the item. An option is removed from an item by swapping
+/// its node with the last active node of the item and decrementing the size: it is restored by incrementing the size back,
+/// in reverse order. The items still to be covered (the enabled elements) are kept the same way, in the first \p nb_active
+/// elements of \p active. Disabled elements are items which may be covered, but need not be: they are never active.
+struct cells {
+  struct cell_item *items; ///< Items, by index of element of the universe.
+  struct cell_node *nodes; ///< Nodes, option after option.
+  unsigned long *set;      ///< Nodes, grouped by item.
+
+  unsigned long *option_start; ///< First node of each option (and one past the last node of the last option.)
+  unsigned long *option_cell;  ///< Element of the node storage of the universe in the subset of each option.
+
+  unsigned long *active;   ///< Items to be covered, the first \p nb_active ones still active.
+  unsigned long nb_active; ///< Number of items still to be covered.
+  unsigned long updates;   ///< Number of nodes removed or restored.
+};
+
+/// Builds the sparse sets of the dancing cells search engine from the links of a search context.
+/// @param [in] context Search context
+/// @return Sparse sets.
+static struct cells *
+dlx_cells_create (SearchContext context) {
+  const struct universe *universe = context->universe;
+  const struct links *links = context->matrix.links;
+  const unsigned long *columns = universe->columns;
+  unsigned long nb_items = universe->nb_elements;
+  struct cells *cells = calloc (1, sizeof (*cells));
+  unsigned char *seen = calloc (universe->nb_subsets + 1, 1);
+  unsigned long nb_options = 0, nb_nodes = 0;
+
+  cells->items = calloc (nb_items + 1, sizeof (*cells->items));
+  cells->active = malloc ((nb_items + 1) * sizeof (*cells->active));
+  for (unsigned long i = 0; i < nb_items; i++)
+    cells->items[i].position = ULONG_MAX;
+
+  // The options are the subsets reachable from the elements still to be covered: the others can not be part of a solution.
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement) {
+    cells->items[columns[c]].rank = cells->items[columns[c]].position = cells->nb_active;
+    cells->active[cells->nb_active++] = columns[c];
+    for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c; r = links[r].elementInNextSubsetContainingThisElementOfUniverse) {
+      unsigned long subset = dlx_universe_subset_of (universe, r);
+
+      if (seen[subset])
+        continue;
+      seen[subset] = 1;
+      nb_options++;
+      unsigned long j = r;
+      do {
+        cells->items[columns[j]].size++;
+        nb_nodes++;
+        j = links[j].nextElement;
+      } while (j != r);
+    }
+  }
+
+  cells->nodes = malloc ((nb_nodes + 1) * sizeof (*cells->nodes));
+  cells->set = malloc ((nb_nodes + 1) * sizeof (*cells->set));
+  cells->option_start = malloc ((nb_options + 1) * sizeof (*cells->option_start));
+  cells->option_cell = malloc ((nb_options + 1) * sizeof (*cells->option_cell));
+
+  for (unsigned long i = 0, start = 0; i < nb_items; i++) {
+    cells->items[i].start = start;
+    start += cells->items[i].size;
+    cells->items[i].size = 0;
+  }
+
+  // Options are numbered in the order they are reached, and their nodes in the order of the elements of their subset.
+  memset (seen, 0, universe->nb_subsets + 1);
+  nb_options = nb_nodes = 0;
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement)
+    for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c; r = links[r].elementInNextSubsetContainingThisElementOfUniverse) {
+      unsigned long subset = dlx_universe_subset_of (universe, r);
+
+      if (seen[subset])
+        continue;
+      seen[subset] = 1;
+      cells->option_start[nb_options] = nb_nodes;
+      cells->option_cell[nb_options] = r;
+      unsigned long j = r;
+      do {
+        struct cell_item *item = &cells->items[columns[j]];
+
+        cells->nodes[nb_nodes].item = columns[j];
+        cells->nodes[nb_nodes].option = nb_options;
+        cells->nodes[nb_nodes].location = item->start + item->size;
+        cells->set[item->start + item->size++] = nb_nodes;
+        nb_nodes++;
+        j = links[j].nextElement;
+      } while (j != r);
+      nb_options++;
+    }
+  cells->option_start[nb_options] = nb_nodes;
+
+  free (seen);
+  return cells;
+}
+
+/// Releases the sparse sets of the dancing cells search engine.
+/// @param [in] cells Sparse sets
+static void
+dlx_cells_destroy (struct cells *cells) {
+  free (cells->items);
+  free (cells->nodes);
+  free (cells->set);
+  free (cells->option_start);
+  free (cells->option_cell);
+  free (cells->active);
+  free (cells);
+}
+
+/// Covers an item: removes the options containing it from the other items.
+/// @param [in] cells Sparse sets
+/// @param [in] i Item
+///
+/// An item to be covered is also removed from the active items.
+static void
+dlx_cells_cover (struct cells *cells, unsigned long i) {
+  struct cell_item *items = cells->items;
+  struct cell_node *nodes = cells->nodes;
+  unsigned long *set = cells->set;
+  unsigned long end = items[i].start + items[i].size;
+
+  for (unsigned long p = items[i].start; p < end; p++) {
+    unsigned long n = set[p];
+    unsigned long option = nodes[n].option;
+    unsigned long last_node = cells->option_start[option + 1];
+
+    for (unsigned long m = cells->option_start[option]; m < last_node; m++) {
+      if (m == n)
+        continue;
+
+      // The node is swapped with the last active node of its item.
+      struct cell_item *item = &items[nodes[m].item];
+      unsigned long last = item->start + --item->size;
+      unsigned long other = set[last];
+
+      set[nodes[m].location] = other;
+      nodes[other].location = nodes[m].location;
+      set[last] = m;
+      nodes[m].location = last;
+    }
+    cells->updates += last_node - cells->option_start[option] - 1;
+  }
+
+  if (items[i].position != ULONG_MAX) {
+    unsigned long last = cells->active[--cells->nb_active];
+
+    cells->active[items[i].position] = last;
+    items[last].position = items[i].position;
+    cells->active[cells->nb_active] = i;
+    items[i].position = cells->nb_active;
+  }
+}
+
+/// Uncovers an item covered by dlx_cells_cover().
+/// @param [in] cells Sparse sets
+/// @param [in] i Item
+///
+/// Removed nodes are still in place, right after the active nodes of their item: they are restored by incrementing sizes back.
+static void
+dlx_cells_uncover (struct cells *cells, unsigned long i) {
+  struct cell_item *items = cells->items;
+  const struct cell_node *nodes = cells->nodes;
+
+  if (items[i].position != ULONG_MAX)
+    cells->nb_active++;
+
+  for (unsigned long p = items[i].start + items[i].size; p-- > items[i].start;) {
+    unsigned long n = cells->set[p];
+    unsigned long option = nodes[n].option;
+
+    for (unsigned long m = cells->option_start[option + 1]; m-- > cells->option_start[option];)
+      if (m != n)
+        items[nodes[m].item].size++;
+    cells->updates += cells->option_start[option + 1] - cells->option_start[option] - 1;
+  }
+}
+
+/// Recursive function to search for solutions with the dancing cells search engine.
+/// @param [in] context Search context
+/// @param [in] cells Sparse sets
+/// @param [in] k Depth of search
+/// @param [in] one_only Stops after the first solution found if 1.
+/// @return Number of solutions found.
+///
+/// Same search as dlx_search(), the sparse sets replacing the links between elements.
+static unsigned long
+dlx_cells_search (SearchContext context, struct cells *cells, unsigned long k, int one_only) {
+  const struct universe *universe = context->universe;
+  const struct cell_item *items = cells->items;
+
+  context->nb_nodes++;
+
+  if (context->nb_nodes == context->next_poll)
+    dlx_search_poll (context, k);
+
+  if (context->checkpoint_requested) {
+    context->checkpoint_requested = 0;
+    if (context->stop_requested) {
+      context->interrupted = 1;
+      return 0;
+    }
+  }
+
+  if (!cells->nb_active) {
+    if (context->max_length && universe->nb_required_subsets + k > context->max_length)
+      return 0;
+
+    dlx_search_solution_count (context, k);
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_SOLUTION, universe->nb_required_subsets + k, ULONG_MAX);
+    dlx_search_display_solution (context, k);
+    return 1;
+  }
+
+  if (context->max_length &&
+      (!universe->max_subset_length ||
+       universe->nb_required_subsets + k + (cells->nb_active + universe->max_subset_length - 1) / universe->max_subset_length > context->max_length))
+    return 0;
+
+  // The item with the fewest active options is chosen (the first one in order of the elements of the universe, in case of ties.)
+  unsigned long i = cells->active[0];
+
+  for (unsigned long a = 1; a < cells->nb_active && items[i].size; a++) {
+    unsigned long j = cells->active[a];
+
+    if (items[j].size < items[i].size || (items[j].size == items[i].size && items[j].rank < items[i].rank))
+      i = j;
+  }
+
+  unsigned long solution_found = 0;
+
+  dlx_cells_cover (cells, i);
+
+  // The active nodes of the chosen item are not moved while its options are tried.
+  for (unsigned long p = items[i].start; p < items[i].start + items[i].size; p++) {
+    unsigned long n = cells->set[p];
+    unsigned long o = cells->nodes[n].option;
+
+    context->solutions[k] = cells->option_cell[o];
+    for (unsigned long m = cells->option_start[o]; m < cells->option_start[o + 1]; m++)
+      if (m != n)
+        dlx_cells_cover (cells, cells->nodes[m].item);
+
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_PUSH, universe->nb_required_subsets + k, dlx_universe_subset_of (universe, cells->option_cell[o]));
+
+    unsigned long branch_solutions = dlx_cells_search (context, cells, k + 1, one_only);
+
+    solution_found += branch_solutions;
+    if (!branch_solutions && context->failures && !context->interrupted)
+      context->failures[dlx_universe_subset_of (universe, cells->option_cell[o])]++;
+
+    if (context->event_handler)
+      dlx_search_notify (context, DLX_EVENT_POP, universe->nb_required_subsets + k, dlx_universe_subset_of (universe, cells->option_cell[o]));
+
+    for (unsigned long m = cells->option_start[o + 1]; m-- > cells->option_start[o];)
+      if (m != n)
+        dlx_cells_uncover (cells, cells->nodes[m].item);
+
+    if ((solution_found && one_only) || context->interrupted)
+      break;
+  }
+
+  dlx_cells_uncover (cells, i);
+
+  return solution_found;
+}
+
+/// Checks whether the dancing cells search engine supports the settings of the search of a search context, propagation aside.
+/// @param [in] context Search context
+/// @return 1 if supported, 0 otherwise.
+///
+/// Symmetries, checkpoints, jobs, progress reports, nogoods and searches for the solution of minimal cost need the links between elements.
+static int
+dlx_cells_supported (SearchContext context) {
+  return !(context->symmetry && context->symmetry->group_size > 1) && !context->path_cost && !context->checkpoint_file && !context->resume_length &&
+         !context->prefix_length && context->split_depth == ULONG_MAX && !context->progress_reporter && !context->nogoods;
+}
+
+/// Checks whether a search can be run by the dancing cells search engine.
+/// @param [in] context Search context
+/// @return 1 if the dancing cells search engine is selected and supports the settings of the search, 0 otherwise.
+///
+/// Propagation needs the links between elements as well.
+static int
+dlx_cells_applicable (SearchContext context) {
+  enum dlx_engine engine = context->engine == DLX_ENGINE_AUTO ? context->choice.engine : context->engine;
+
+  return engine == DLX_ENGINE_CELLS && !dlx_search_propagation (context) && dlx_cells_supported (context);
+}
+
+/// Subset containing an element, with the key of its order.
+struct subset_rank {
+  double key;         ///< Key of the subset (smallest first.)
+  unsigned long node; ///< Element of the subset in the node storage (ties in order of definition.)
+};
+
+/// Compares two subsets by their keys (for qsort).
+static int
+dlx_subset_rank_compare (const void *a, const void *b) {
+  const struct subset_rank *ra = a;
+  const struct subset_rank *rb = b;
+
+  if (ra->key != rb->key)
+    return ra->key < rb->key ? -1 : 1;
+  return (ra->node > rb->node) - (ra->node < rb->node);
+}
+
+/// Orders the subsets containing an element of the universe in the links of a search context.
+/// @param [in] context Search context
+/// @param [in] c Element of the universe in the node storage
+/// @param [in] keys Key of each subset (smallest first.)
+/// @param [in] ranks Buffer for the subsets containing the element.
+static void
+dlx_search_order_element (SearchContext context, unsigned long c, const double *keys, struct subset_rank *ranks) {
+  struct links *links = context->matrix.links;
+  unsigned long nb_ranks = 0;
+
+  for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c; r = links[r].elementInNextSubsetContainingThisElementOfUniverse) {
+    ranks[nb_ranks].key = keys[dlx_universe_subset_of (context->universe, r)];
+    ranks[nb_ranks++].node = r;
+  }
+  qsort (ranks, nb_ranks, sizeof (*ranks), dlx_subset_rank_compare);
+
+  unsigned long previous = c;
+
+  for (unsigned long n = 0; n < nb_ranks; n++) {
+    links[previous].elementInNextSubsetContainingThisElementOfUniverse = ranks[n].node;
+    links[ranks[n].node].elementInPreviousSubsetContainingThisElementOfUniverse = previous;
+    previous = ranks[n].node;
+  }
+  links[previous].elementInNextSubsetContainingThisElementOfUniverse = c;
+  links[c].elementInPreviousSubsetContainingThisElementOfUniverse = previous;
+}
+
+/// Orders the subsets containing each element of the links of a search context, according to the order of subsets of the search context.
+/// @param [in] context Search context
+///
+/// Each list of subsets containing an element is sorted once, and linked again in that order.
+/// Elements covered by subsets required in solutions are left as they are.
+static void
+dlx_search_order_subsets (SearchContext context) {
+  const struct universe *universe = context->universe;
+  struct matrix *matrix = &context->matrix;
+  struct links *links = matrix->links;
+  const unsigned long *columns = universe->columns;
+  enum dlx_subset_order order = dlx_search_subset_order (context);
+
+  if (order == DLX_ORDER_DEFINITION && !context->reordered)
+    return;
+
+  if (order == DLX_ORDER_FAILURES && !context->failures)
+    context->failures = calloc (universe->nb_subsets + 1, sizeof (*context->failures));
+
+  // Keys are computed once per subset, from the elements of the subset.
+  double *keys = calloc (universe->nb_subsets + 1, sizeof (*keys));
+
+  for (unsigned long s = 0; s < universe->nb_subsets; s++) {
+    unsigned long first = universe->subsets[s].node, length = 0;
+    double removed = 0;
+
+    for (unsigned long j = first; !length || j != first; j = links[j].nextElement) {
+      length++;
+      removed += (double)matrix->size[columns[j]] - 1; // The choice of the subset removes the other subsets containing its elements.
+    }
+
+    switch (order) {
+    case DLX_ORDER_SHORTEST:
+      keys[s] = (double)length;
+      break;
+    case DLX_ORDER_LONGEST:
+      keys[s] = -(double)length;
+      break;
+    case DLX_ORDER_PRIORITY:
+      keys[s] = -universe->subsets[s].priority;
+      break;
+    case DLX_ORDER_LEAST_CONSTRAINING:
+      keys[s] = removed;
+      break;
+    case DLX_ORDER_FAILURES:
+      keys[s] = (double)context->failures[s];
+      break;
+    default:
+      break;
+    }
+  }
+
+  // The elements to be covered are linked from the head, the disabled elements are not.
+  struct subset_rank *ranks = malloc ((universe->nb_subsets + 1) * sizeof (*ranks));
+
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement)
+    dlx_search_order_element (context, c, keys, ranks);
+  for (unsigned long i = 0; i < universe->nb_elements; i++)
+    if (universe->elements[i].disabled)
+      dlx_search_order_element (context, universe->elements[i].node, keys, ranks);
+
+  free (ranks);
+  free (keys);
+  context->reordered = order != DLX_ORDER_DEFINITION;
+}
+
+/// Searches for solutions from the root of the search tree.
+/// @param [in] context Search context
+/// @param [in] one_only Stops after the first solution found if 1.
+/// @return Number of solutions found.
+///
+/// The event handler, if any, is notified of the subsets required in solutions as if they were the first subsets added to the solution.
+static unsigned long
+dlx_search_root (SearchContext context, int one_only) {
+  const struct universe *universe = context->universe;
+
+  unsigned long faults = dlx_memory_faults ();
+
+  // Nogoods are not sound when solutions are pruned by the path that leads to them (symmetries, lengths, costs),
+  // or when branches are skipped (resumed searches, jobs.)
+  context->nogoods_active = context->nogoods && !(context->symmetry && context->symmetry->group_size > 1) && !context->max_length &&
+                            !context->path_cost && !context->resume_length && !context->prefix_length && context->split_depth == ULONG_MAX;
+  context->nogood_statistics.lookups = context->nogood_statistics.hits = 0;
+  context->nogood_statistics.recorded = context->nogood_statistics.replaced = 0;
+  if (context->nogoods_active)
+    dlx_nogoods_prepare (context);
+
+  if (context->subset_order == DLX_ORDER_FAILURES && dlx_search_subset_order (context) == DLX_ORDER_DEFINITION)
+    DLX_PRINT (context, "Subsets tried in order of definition (the order of failures can not be reproduced by checkpoints and jobs.)\n");
+  dlx_search_order_subsets (context);
+
+  if (context->event_handler)
+    for (unsigned long k = 0; k < universe->nb_required_subsets; k++)
+      dlx_search_notify (context, DLX_EVENT_PUSH, k, universe->required_subsets[k]);
+
+  unsigned long nb_solutions;
+
+  if (dlx_cells_applicable (context)) {
+    struct cells *cells = dlx_cells_create (context);
+
+    nb_solutions = dlx_cells_search (context, cells, 0, one_only);
+    context->matrix.updates += cells->updates;
+    dlx_cells_destroy (cells);
+  } else
+    nb_solutions = dlx_search (context, 0, one_only);
+
+  if (context->event_handler)
+    for (unsigned long k = universe->nb_required_subsets; k-- > 0;)
+      dlx_search_notify (context, DLX_EVENT_POP, k, universe->required_subsets[k]);
+
+  context->memory.search_faults = dlx_memory_faults () - faults;
+  context->memory_stale = 1;
+  if (context->nogoods_active)
+    DLX_PRINT (context, "Nogoods: %lu hit%s out of %lu lookup%s, %lu recorded (%lu replaced), %lu stored.\n", context->nogood_statistics.hits,
+               context->nogood_statistics.hits == 1 ? "" : "s", context->nogood_statistics.lookups, context->nogood_statistics.lookups == 1 ? "" : "s",
+               context->nogood_statistics.recorded, context->nogood_statistics.replaced, context->nogood_statistics.stored);
+  context->nogoods_active = 0;
+
+  return nb_solutions;
+}
+
+/// Gathers the statistics of the model searched by a search context.
+/// @param [in] context Search context
+/// @param [out] choice Statistics of the model.
+static void
+dlx_search_statistics (SearchContext context, struct dlx_auto_choice *choice) {
+  const struct universe *universe = context->universe;
+  const struct links *links = context->matrix.links;
+  unsigned char *seen = calloc (universe->nb_subsets + 1, 1);
+
+  memset (choice, 0, sizeof (*choice));
+  choice->min_element_size = ULONG_MAX;
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement) {
+    unsigned long size = context->matrix.size[universe->columns[c]];
+
+    choice->nb_elements++;
+    choice->mean_element_size += size;
+    if (size < choice->min_element_size)
+      choice->min_element_size = size;
+    if (size > choice->max_element_size)
+      choice->max_element_size = size;
+
+    for (unsigned long r = links[c].elementInNextSubsetContainingThisElementOfUniverse; r != c; r = links[r].elementInNextSubsetContainingThisElementOfUniverse) {
+      unsigned long subset = dlx_universe_subset_of (universe, r), length = 0;
+
+      if (seen[subset])
+        continue;
+      seen[subset] = 1;
+      for (unsigned long j = links[r].nextElement; j != r; j = links[j].nextElement)
+        length++;
+      length++;
+      choice->nb_subsets++;
+      choice->nb_cells += length;
+      if (length > choice->max_subset_length)
+        choice->max_subset_length = length;
+    }
+  }
+  free (seen);
+
+  if (!choice->nb_elements)
+    choice->min_element_size = 0;
+  else
+    choice->mean_element_size /= choice->nb_elements;
+  if (choice->nb_subsets) {
+    choice->mean_subset_length = (double)choice->nb_cells / choice->nb_subsets;
+    choice->density = (double)choice->nb_cells / ((double)choice->nb_subsets * choice->nb_elements);
+  }
+}
+
+/// Runs a search with the budget of nodes of the calibration on a scratch search context.
+/// @param [in] scratch Scratch search context
+/// @param [in] engine Search engine
+/// @param [in] propagation Propagation setting
+/// @param [in] one_only Set if the search is for the first solution only.
+/// @param [out] complete Set if the whole search tree was explored (or the first solution found) within the budget.
+/// @return Time of the search, in milliseconds.
+static double
+dlx_search_calibrate (SearchContext scratch, enum dlx_engine engine, int propagation, int one_only, int *complete) {
+  scratch->engine = engine;
+  scratch->propagation = propagation;
+  scratch->nb_solutions = scratch->nb_solutions_total = scratch->nb_nodes = scratch->matrix.updates = 0;
+  scratch->nb_forced = scratch->nb_dead_ends = scratch->nb_path_forced = 0;
+  scratch->interrupted = 0;
+  scratch->node_limit = scratch->calibration_nodes;
+  dlx_search_schedule (scratch);
+
+  double start = dlx_clock_milliseconds ();
+
+  dlx_search_root (scratch, one_only);
+  double elapsed = dlx_clock_milliseconds () - start;
+
+  *complete = !scratch->interrupted;
+  scratch->stop_requested = scratch->checkpoint_requested = 0;
+
+  return elapsed;
+}
+
+/// Compares two calibration runs.
+/// @param [in] milliseconds Time of the first run
+/// @param [in] complete Set if the first run explored the whole search tree.
+/// @param [in] other_milliseconds Time of the second run
+/// @param [in] other_complete Set if the second run explored the whole search tree.
+/// @return 1 if the first run did better: it explored the whole search tree and the second one did not, or it was faster otherwise.
+static int
+dlx_calibration_better (double milliseconds, int complete, double other_milliseconds, int other_complete) {
+  return complete != other_complete ? complete : milliseconds < other_milliseconds;
+}
+
+/// Chooses the search engine, propagation and order of subsets of a search context in automatic mode.
+/// @param [in] context Search context
+/// @param [in] resuming Set if the search is resumed from a checkpoint.
+/// @param [in] one_only Set if the search is for the first solution only.
+///
+/// The choice is based on the statistics of the model, and on short calibration runs if a budget of nodes is set:
+/// - the engine which explores the budget of nodes faster is chosen, or, without calibration, the dancing cells engine for long subsets,
+///   if it supports the settings of the search;
+/// - propagation is chosen if it explores the whole search tree within the budget, faster than the chosen engine or when the engine does not,
+///   or, without calibration, if a fourth of the elements are left in at most two subsets (choices are then often forced), unless there are too many elements to scan;
+/// - the least constraining subsets are tried first by searches for the first solution, unless another order was set
+///   (the order of subsets does not change the search tree of a search for all solutions, only the order it is explored in);
+/// - several worker processes are recommended unless the calibration explored the whole search tree (or, without calibration, for small models.)
+///
+/// Propagation and the order of subsets are left unchanged, and no calibration is run, with checkpoints and jobs (they are part of the fingerprint of the search.)
+/// The choice applies to the search only: the settings of the search context are not changed.
+/// The calibration runs with the settings of the search, and is only run again once the model or those settings changed.
+static void
+dlx_search_auto_select (SearchContext context, int resuming, int one_only) {
+  struct dlx_auto_choice *choice = &context->choice;
+  const struct links *links = context->matrix.links;
+  // The frontier of a checkpointed search, or of jobs, must not be changed.
+  int unconstrained = !resuming && !context->checkpoint_file && context->split_depth == ULONG_MAX && !context->result;
+  int cells = dlx_cells_supported (context);
+  int parallel;
+  unsigned long nb_few = 0;
+
+  // The settings of the search context apply until the choice is made.
+  choice->nb_workers = 0;
+  dlx_search_statistics (context, choice);
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement)
+    if (context->matrix.size[context->universe->columns[c]] <= 2)
+      nb_few++;
+
+  choice->engine = cells && choice->mean_subset_length >= DLX_AUTO_CELLS_SUBSET_LENGTH ? DLX_ENGINE_CELLS : DLX_ENGINE_LINKS;
+  choice->propagation = unconstrained ? choice->nb_elements <= DLX_AUTO_PROPAGATION_MAX_ELEMENTS && 4 * nb_few >= choice->nb_elements
+                                      : context->propagation;
+  choice->subset_order = unconstrained && one_only && context->subset_order == DLX_ORDER_DEFINITION ? DLX_ORDER_LEAST_CONSTRAINING : context->subset_order;
+  parallel = choice->nb_subsets >= DLX_AUTO_WORKERS_MIN_SUBSETS;
+
+  if (context->calibration_nodes && unconstrained) {
+    struct dlx_auto_choice *calibrated = &context->calibrated;
+    unsigned long long fingerprint = dlx_search_fingerprint (context);
+
+    // The calibration is only run again if the model, the settings of the search or the budget changed since the last one.
+    if (calibrated->calibration_nodes != context->calibration_nodes || context->calibrated_fingerprint != fingerprint ||
+        context->calibrated_one_only != one_only || context->calibrated_cells != cells) {
+      // Calibration runs on a scratch search context, so that it leaves no trace on the search context:
+      // no solution, event, trace or progress report, no nogood recorded and no failure counted.
+      SearchContext scratch = dlx_search_context_create (context->universe);
+      int links_complete, cells_complete = 0, propagation_complete;
+
+      scratch->solution_displayer = 0;
+      scratch->sink = 0;
+      scratch->trace = 0;
+      scratch->max_length = context->max_length;
+      scratch->subset_order = choice->subset_order;
+      scratch->calibration_nodes = context->calibration_nodes;
+      // The group of symmetries of the search context is shared.
+      dlx_symmetry_group_free (scratch->own_symmetry);
+      scratch->own_symmetry = 0;
+      scratch->symmetry = context->symmetry;
+
+      calibrated->calibration_nodes = context->calibration_nodes;
+      calibrated->links_milliseconds = dlx_search_calibrate (scratch, DLX_ENGINE_LINKS, 0, one_only, &links_complete);
+      // The dancing cells engine is only tried if it supports the settings of the search (otherwise the links engine would be run again.)
+      calibrated->cells_milliseconds = cells ? dlx_search_calibrate (scratch, DLX_ENGINE_CELLS, 0, one_only, &cells_complete) : HUGE_VAL;
+      calibrated->propagation_milliseconds = dlx_search_calibrate (scratch, DLX_ENGINE_LINKS, 1, one_only, &propagation_complete);
+      dlx_search_context_destroy (scratch);
+
+      calibrated->calibration_complete = links_complete || cells_complete || propagation_complete;
+      calibrated->engine = cells && dlx_calibration_better (calibrated->cells_milliseconds, cells_complete, calibrated->links_milliseconds, links_complete)
+                               ? DLX_ENGINE_CELLS
+                               : DLX_ENGINE_LINKS;
+      if (calibrated->engine == DLX_ENGINE_CELLS)
+        calibrated->propagation =
+            propagation_complete && dlx_calibration_better (calibrated->propagation_milliseconds, 1, calibrated->cells_milliseconds, cells_complete);
+      else
+        calibrated->propagation =
+            propagation_complete && dlx_calibration_better (calibrated->propagation_milliseconds, 1, calibrated->links_milliseconds, links_complete);
+      context->calibrated_fingerprint = fingerprint;
+      context->calibrated_one_only = one_only;
+      context->calibrated_cells = cells;
+    }
+
+    choice->calibration_nodes = calibrated->calibration_nodes;
+    choice->links_milliseconds = calibrated->links_milliseconds;
+    choice->cells_milliseconds = calibrated->cells_milliseconds;
+    choice->propagation_milliseconds = calibrated->propagation_milliseconds;
+    choice->calibration_complete = calibrated->calibration_complete;
+    choice->engine = calibrated->engine;
+    choice->propagation = calibrated->propagation;
+    parallel = !choice->calibration_complete;
+  }
+
+  // The dancing cells engine does not propagate.
+  if (choice->propagation)
+    choice->engine = DLX_ENGINE_LINKS;
+
+  choice->nb_workers = 1;
+  if (parallel) {
+    long nb_processors = sysconf (_SC_NPROCESSORS_ONLN);
+
+    choice->nb_workers = nb_processors > 1 ? (unsigned long)nb_processors : 1;
+  }
+
+  DLX_PRINT (context,
+             "Automatic selection: %lu elements, %lu subsets, density %g, subsets of %g elements on average (%lu at most), "
+             "elements in %lu to %lu subsets (%g on average): %s engine%s%s, %lu worker%s recommended.\n",
+             choice->nb_elements, choice->nb_subsets, choice->density, choice->mean_subset_length, choice->max_subset_length, choice->min_element_size,
+             choice->max_element_size, choice->mean_element_size, choice->engine == DLX_ENGINE_CELLS ? "dancing cells" : "dancing links",
+             choice->propagation ? " with propagation" : "", choice->subset_order == DLX_ORDER_LEAST_CONSTRAINING ? ", least constraining subsets first" : "",
+             choice->nb_workers, choice->nb_workers == 1 ? "" : "s");
+}
+
+dlx_solution_displayer
+dlx_displayer_set (Universe universe, dlx_solution_displayer msd, void *data) __attribute__ ((overloadable)) {
+  dlx_solution_displayer old = universe->solution_displayer;
+
+  universe->solution_displayer = msd;
+  universe->solution_displayer_data = data;
+  return old;
+}
+
+dlx_solution_displayer
+dlx_displayer_set (SearchContext context, dlx_solution_displayer msd, void *data) __attribute__ ((overloadable)) {
+  dlx_solution_displayer old = context->solution_displayer;
+
+  context->solution_displayer = msd;
+  context->solution_displayer_data = data;
+  return old;
+}
+
+int
+dlx_trace_set (Universe universe, int trace) __attribute__ ((overloadable)) {
+  int old = universe->trace;
+
+  universe->trace = trace;
+  return old;
+}
+
+int
+dlx_trace_set (SearchContext context, int trace) __attribute__ ((overloadable)) {
+  int old = context->trace;
+
+  context->trace = trace;
+  return old;
+}
+
+/// Hashes a name.
+/// @param [in] name Name
+/// @return Hash of the name.
+static unsigned long
+dlx_name_hash (const char *name) {
+  unsigned long long hash = 14695981039346656037ULL; // FNV-1a
+
+  for (; *name; name++)
+    hash = (hash ^ (unsigned char)*name) * 1099511628211ULL;
+
+  return hash;
+}
+
+/// Gets the index of the subset stored before a name of a subset in the storage of names.
+/// @param [in] name Name of a subset, as stored by dlx_universe_subset_name_copy().
+/// @return Index of the subset (of the identical subset for the name of a merged subset.)
+static unsigned long
+dlx_name_subset (const char *name) {
+  unsigned long subset;
+
+  memcpy (&subset, name - sizeof (subset), sizeof (subset));
+  return subset;
+}
+
+/// Reserves a slot in the hash table of names of a universe.
+/// @param [in] universe Universe
+/// @return 1 if a name can be inserted, 0 if memory is exhausted.
+///
+/// The table is open addressed (with linear probing), and kept at most half full: it is doubled when needed.
+/// If it can not be doubled, it is used as long as a slot is left free.
+static int
+dlx_universe_name_table_reserve (Universe universe) {
+  if (2 * (universe->name_table_length + 1) <= universe->name_table_capacity)
+    return 1;
+
+  unsigned long capacity = universe->name_table_capacity ? 2 * universe->name_table_capacity : 64;
+  struct name_slot *table = calloc (capacity, sizeof (*table));
+
+  if (!table)
+    return universe->name_table_length + 1 < universe->name_table_capacity;
+
+  for (unsigned long i = 0; i < universe->name_table_capacity; i++)
+    if (universe->name_table[i].name) {
+      unsigned long j = universe->name_table[i].hash & (capacity - 1);
+
+      while (table[j].name)
+        j = (j + 1) & (capacity - 1);
+      table[j] = universe->name_table[i];
+    }
+  free (universe->name_table);
+  universe->name_table = table;
+  universe->name_table_capacity = capacity;
+
+  return 1;
+}
+
+/// Inserts a name of a subset in the hash table of names of a universe.
+/// @param [in] universe Universe
+/// @param [in] name Name of a subset, as stored by dlx_universe_subset_name_copy().
+/// @pre A slot was reserved by dlx_universe_name_table_reserve().
+static void
+dlx_universe_name_table_insert (Universe universe, const char *name) {
+  unsigned long hash = dlx_name_hash (name);
+  unsigned long mask = universe->name_table_capacity - 1;
+  unsigned long i = hash & mask;
+
+  while (universe->name_table[i].name)
+    i = (i + 1) & mask;
+  universe->name_table[i].hash = hash;
+  universe->name_table[i].name = name;
+  universe->name_table[i].disabled = 0;
+  universe->name_table_length++;
+}
+
+/// Looks for a name of a subset in the hash table of names of a universe.
+/// @param [in] universe Universe
+/// @param [in] name Name looked for
+/// @param [in] hash Hash of \p name
+/// @param [in] slot Slot where the search starts: the first slot of the name (see dlx_universe_name_first()), or the slot after the last slot found.
+/// @return Slot of the next subset (or merged subset) of this name, or ULONG_MAX if none.
+///
+/// Subsets with the same name are not found in order of definition.
+static unsigned long
+dlx_universe_name_next (const struct universe *universe, const char *name, unsigned long hash, unsigned long slot) {
+  if (!universe->name_table_capacity)
+    return ULONG_MAX;
+
+  unsigned long mask = universe->name_table_capacity - 1;
+
+  for (unsigned long i = slot & mask; universe->name_table[i].name; i = (i + 1) & mask)
+    if (universe->name_table[i].hash == hash && (universe->name_table[i].name == name || !strcmp (universe->name_table[i].name, name)))
+      return i;
+
+  return ULONG_MAX;
+}
+
+/// Looks for the first slot of a name of a subset in the hash table of names of a universe.
+/// @param [in] universe Universe
+/// @param [in] name Name looked for
+/// @param [in] hash Hash of \p name
+/// @return Slot of a subset (or merged subset) of this name, or ULONG_MAX if none.
+///
+/// The other subsets of this name are found by dlx_universe_name_next() from the slot after.
+static unsigned long
+dlx_universe_name_first (const struct universe *universe, const char *name, unsigned long hash) {
+  return dlx_universe_name_next (universe, name, hash, hash);
+}
+
+/// Checks whether a slot of the hash table of names holds the name of a subset merged into an identical subset.
+/// @param [in] universe Universe
+/// @param [in] slot Slot of the hash table of names
+/// @return 1 for the name of a merged subset, 0 for the name of a subset.
+static int
+dlx_universe_name_merged (const struct universe *universe, unsigned long slot) {
+  const char *name = universe->name_table[slot].name;
+
+  return universe->subsets[dlx_name_subset (name)].name != name;
+}
+
+/// Checks whether a name is held by the storage of names of a universe, after the index of a subset.
+/// @param [in] universe Universe
+/// @param [in] name Name
+/// @return 1 if the index of a subset can be read right before the name, 0 otherwise.
+static int
+dlx_universe_name_pooled (const struct universe *universe, const char *name) {
+  uintptr_t address = (uintptr_t)name;
+
+  for (unsigned long i = 0; i < universe->nb_name_pools; i++) {
+    uintptr_t names = (uintptr_t)universe->name_pools[i]->names;
+
+    if (address >= names + sizeof (unsigned long) && address < names + universe->name_pools[i]->length)
+      return 1;
+  }
+
+  return 0;
+}
+
+unsigned long
+dlx_subset_index (Universe universe, const char *subset_name) {
+  if (!universe || !subset_name)
+    return ULONG_MAX;
+
+  // The index of the subset is stored right before the names passed by the library.
+  if (dlx_universe_name_pooled (universe, subset_name)) {
+    unsigned long subset = dlx_name_subset (subset_name);
+
+    if (subset < universe->nb_subsets && universe->subsets[subset].name == subset_name)
+      return subset;
+  }
+
+  // Other names (copies) are looked up: the first subset of that name, or else the subset a subset of that name was merged into.
+  unsigned long hash = dlx_name_hash (subset_name), subset = ULONG_MAX, merged = ULONG_MAX;
+
+  for (unsigned long slot = dlx_universe_name_first (universe, subset_name, hash); slot != ULONG_MAX;
+       slot = dlx_universe_name_next (universe, subset_name, hash, slot + 1)) {
+    unsigned long s = dlx_name_subset (universe->name_table[slot].name);
+
+    if (!dlx_universe_name_merged (universe, slot))
+      subset = s < subset ? s : subset;
+    else if (merged == ULONG_MAX)
+      merged = s;
+  }
+
+  return subset != ULONG_MAX ? subset : merged;
+}
+
+Universe
+dlx_universe_create (void) __attribute__ ((overloadable)) {
+  Universe universe = malloc (sizeof (*universe));
+
+  universe->columns = 0;
+  universe->rows = 0;
+  universe->nb_nodes = 0;
+  universe->nodes_capacity = 0;
+  universe->matrix.links = 0;
+  universe->matrix.size = 0;
+  universe->matrix.updates = 0;
+  universe->name_pools = 0;
+  universe->nb_name_pools = 0;
+
+  dlx_universe_new_node (universe); // HEAD
+  universe->matrix.links[HEAD].previousElement = universe->matrix.links[HEAD].nextElement = HEAD;
+  // Other unused components of head are left undefined.
+
+  universe->uncover_column = 0;
+  universe->uncover_column_length = 0;
+  universe->required_subsets = 0;
+  universe->required_names = 0;
+  universe->nb_required_subsets = 0;
+  universe->assumptions = 0;
+  universe->nb_assumptions = 0;
+  universe->conflict.reason = DLX_CONFLICT_NONE;
+  universe->conflict.subset = universe->conflict.element = universe->conflict.required = 0;
+  universe->solution_displayer = 0;
+  universe->solution_displayer_data = 0;
+  universe->unbound = 1; // Unboud universe.
+  universe->subset_table = 0;
+  universe->subset_table_capacity = 0;
+  universe->nb_duplicates = 0;
+  universe->name_table = 0;
+  universe->name_table_capacity = 0;
+  universe->name_table_length = 0;
+  universe->elements = 0;
+  universe->nb_elements = 0;
+  universe->subsets = 0;
+  universe->nb_subsets = 0;
+  universe->symmetry = 0;
+  universe->nb_solutions_total = 0;
+  universe->propagation = 0;
+  universe->nb_forced = universe->nb_dead_ends = 0;
+  universe->cost = HUGE_VAL;
+  universe->max_length = 0;
+  universe->max_subset_length = 0;
+  universe->sink = 0;
+  universe->engine = DLX_ENGINE_LINKS;
+  universe->subset_order = DLX_ORDER_DEFINITION;
+  universe->memory_policy = DLX_MEMORY_DEFAULT;
+  universe->calibration_nodes = 0;
+  memset (&universe->choice, 0, sizeof (universe->choice));
+
+  // The default trace setting is read from the environment (DLX_TRACE).
+  const char *trace = getenv ("DLX_TRACE");
+
+  universe->trace = trace && *trace && strcmp (trace, "0");
+
+  return universe;
+}
+
+Universe
+dlx_universe_create (unsigned long nb_elements, const char *elements[]) __attribute__ ((overloadable)) {
+  if (!nb_elements || !elements)
+    return 0;
+
+  /// @overload
+  Universe universe = dlx_universe_create ();
+  universe->unbound = 0; // Bound universe.
+
+  DLX_PRINT (universe, "Elements in universe:");
+  int redo = 0;
+
+  for (unsigned long i = 0; i < nb_elements; i++) {
+    if (!elements[i] || !*elements[i])
+      continue;
+
+    DLX_PRINT (universe, " %s", elements[i]);
+    if (!dlx_universe_add_element (universe, elements[i])) {
+      DLX_PRINT (universe, " (already exists ==> not added)");
+      redo = 1;
+    }
+  }
+
+  if (redo) {
+    DLX_PRINT (universe, " =");
+    for (unsigned long element = universe->matrix.links[HEAD].nextElement; element != HEAD;
+         element = universe->matrix.links[element].nextElement)
+      DLX_PRINT (universe, " %s", universe->elements[universe->columns[element]].name);
+  }
+
+  DLX_PRINT (universe, "\n");
+
+  return universe;
+}
+
+Universe
+dlx_universe_create (const char *elements, const char *separators) __attribute__ ((overloadable)) {
+  if (!elements)
+    return 0;
+
+  char *sccpy;
+  char *saveptr;
+  unsigned long nb_cols;
+
+  sccpy = strdup (elements);
+  nb_cols = 0;
+  for (char *c = sccpy; strtok_r (c, separators, &saveptr); c = 0)
+    nb_cols++;
+  free (sccpy);
+
+  if (!nb_cols)
+    return 0;
+
+  const char *cols[nb_cols];
+  char *colname;
+
+  sccpy = strdup (elements);
+  nb_cols = 0;
+  for (char *c = sccpy; (colname = strtok_r (c, separators, &saveptr)); c = 0)
+    cols[nb_cols++] = colname;
+
+  /// @overload
+  Universe ret = dlx_universe_create (nb_cols, cols);
+
+  free (sccpy);
+
+  return ret;
+}
+
+/// Computes the hash of a subset.
+/// @param [in] elements Sorted indices of the elements of the universe contained in the subset.
+/// @param [in] length Number of elements contained in the subset.
+/// @return Hash of the subset.
+static unsigned long
+dlx_subset_hash (const unsigned long *elements, unsigned long length) {
+  unsigned long long hash = 14695981039346656037ULL; // FNV-1a
+
+  for (unsigned long i = 0; i < length; i++)
+    hash = (hash ^ elements[i]) * 1099511628211ULL;
+
+  return (unsigned long)hash;
+}
+
+/// Gets the elements of a subset.
+/// @param [in] universe Universe
+/// @param [in] subset Index of the subset
+/// @param [out] elements Sorted indices of the elements of the universe contained in the subset.
+/// @return Number of elements contained in the subset.
+static unsigned long
+dlx_universe_subset_elements (const struct universe *universe, unsigned long subset, unsigned long *elements) {
+  unsigned long first = universe->subsets[subset].node;
+  unsigned long length = 0;
+  unsigned long j = first;
+
+  do {
+    elements[length++] = universe->columns[j];
+    j = universe->matrix.links[j].nextElement;
+  } while (j != first);
+  qsort (elements, length, sizeof (*elements), dlx_index_compare);
+
+  return length;
+}
+
+/// Inserts a subset in the hash table of subsets.
+/// @param [in] universe Universe
+/// @param [in] hash Hash of the subset
+/// @param [in] subset Index of the subset
+///
+/// The table is open addressed (with linear probing), and kept at most half full: it is doubled when needed.
+/// It holds at most one slot per subset (merged subsets are not inserted.)
+static void
+dlx_universe_subset_table_insert (Universe universe, unsigned long hash, unsigned long subset) {
+  if (2 * universe->nb_subsets > universe->subset_table_capacity) {
+    struct subset_slot *table = universe->subset_table;
+    unsigned long capacity = universe->subset_table_capacity;
+    struct subset_slot *doubled = malloc (2 * capacity * sizeof (*doubled));
+
+    // If the table can not be doubled, it is used as long as a slot is left free (subsets which can not be inserted are not merged.)
+    if (doubled) {
+      universe->subset_table = doubled;
+      universe->subset_table_capacity *= 2;
+      for (unsigned long i = 0; i < universe->subset_table_capacity; i++)
+        universe->subset_table[i].subset = ULONG_MAX;
+      for (unsigned long i = 0; i < capacity; i++)
+        if (table[i].subset != ULONG_MAX)
+          dlx_universe_subset_table_insert (universe, table[i].hash, table[i].subset);
+      free (table);
+    } else if (subset + 1 >= capacity)
+      return;
+  }
+
+  unsigned long mask = universe->subset_table_capacity - 1;
+  unsigned long i = hash & mask;
+
+  while (universe->subset_table[i].subset != ULONG_MAX)
+    i = (i + 1) & mask;
+  universe->subset_table[i].hash = hash;
+  universe->subset_table[i].subset = subset;
+}
+
+/// Looks for a subset identical to a subset to be defined.
+/// @param [in] universe Universe
+/// @param [in] hash Hash of the subset to be defined
+/// @param [in] elements Sorted indices of the elements of the universe contained in the subset to be defined.
+/// @param [in] length Number of elements contained in the subset to be defined.
+/// @param [in] weight Weight of the subset to be defined.
+/// @return Index of an enabled subset with the same elements and weight, or ULONG_MAX if none.
+static unsigned long
+dlx_universe_subset_find (const struct universe *universe, unsigned long hash, const unsigned long *elements, unsigned long length, double weight) {
+  unsigned long mask = universe->subset_table_capacity - 1;
+  unsigned long other[universe->max_subset_length + 1];
+
+  for (unsigned long i = hash & mask; universe->subset_table[i].subset != ULONG_MAX; i = (i + 1) & mask) {
+    const struct subset *subset = &universe->subsets[universe->subset_table[i].subset];
+
+    if (universe->subset_table[i].hash == hash && !subset->disabled && subset->weight == weight &&
+        !dlx_indices_compare (other, dlx_universe_subset_elements (universe, universe->subset_table[i].subset, other), elements, length))
+      return universe->subset_table[i].subset;
+  }
+
+  return ULONG_MAX;
+}
+
+/// Adds a subset to the universe.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the added subset
+/// @param [in] weight Cost of the subset in a solution.
+/// @param [in] nb_elements Number of elements of the universe contained in the subset.
+/// @param [in] elementsInUniverse Indices in the node storage of the elements of the universe contained in the subset, all distinct.
+/// @return Index in the node storage of the first element of the subset, or HEAD if the subset is empty.
+///
+/// If identical subsets are merged, and an enabled subset with the same elements and weight was already defined,
+/// the multiplicity of this subset is incremented instead, and its first element is returned.
+static unsigned long
+dlx_universe_subset_add (Universe universe, const char *subset_name, double weight, unsigned long nb_elements, const unsigned long elementsInUniverse[]) {
+  unsigned long first_element = HEAD;
+  unsigned long hash = 0;
+
+  // The name is indexed, whether the subset is added or merged.
+  if (nb_elements && !dlx_universe_name_table_reserve (universe)) {
+    DLX_PRINT (universe, " (out of memory ==> not added)");
+    return HEAD;
+  }
+
+  if (universe->subset_table && nb_elements) {
+    unsigned long sorted[nb_elements];
+
+    for (unsigned long i = 0; i < nb_elements; i++)
+      sorted[i] = universe->columns[elementsInUniverse[i]];
+    qsort (sorted, nb_elements, sizeof (*sorted), dlx_index_compare);
+    hash = dlx_subset_hash (sorted, nb_elements);
+
+    unsigned long same = dlx_universe_subset_find (universe, hash, sorted, nb_elements, weight);
+
+    if (same != ULONG_MAX) {
+      universe->subsets[same].multiplicity++;
+      universe->nb_duplicates++;
+      // The name of the merged subset is kept as another name of the identical subset.
+      if (*subset_name && strcmp (subset_name, universe->subsets[same].name)) {
+        dlx_universe_name_table_insert (universe, dlx_universe_subset_name_copy (universe, subset_name, same));
+      }
+      DLX_PRINT (universe, " (identical to subset %s ==> merged, multiplicity %lu)", *universe->subsets[same].name ? universe->subsets[same].name : "(unnamed)",
+                 universe->subsets[same].multiplicity);
+      return universe->subsets[same].node;
+    }
+  }
+
+  for (unsigned long i = 0; i < nb_elements; i++) {
+    unsigned long elementInUniverse = elementsInUniverse[i];
+
+    // Add element in subset
+    unsigned long elementInSubset = dlx_universe_new_node (universe);
+    struct links *links = universe->matrix.links;
+
+    universe->columns[elementInSubset] = universe->columns[elementInUniverse];
+    universe->rows[elementInSubset] = universe->nb_subsets;
+    universe->matrix.size[universe->columns[elementInUniverse]]++; // Number of subsets containing the element is incremented
+
+    /// The element of the universe and subsets containing this element of the universe are doubly linked as circular lists (\p elementInPreviousSubsetContainingThisElementOfUnivers and \p elementInNextSubsetContainingThisElementOfUnivers).
+    links[elementInSubset].elementInNextSubsetContainingThisElementOfUniverse = elementInUniverse;
+    links[elementInSubset].elementInPreviousSubsetContainingThisElementOfUniverse = links[elementInUniverse].elementInPreviousSubsetContainingThisElementOfUniverse;
+    links[links[elementInUniverse].elementInPreviousSubsetContainingThisElementOfUniverse].elementInNextSubsetContainingThisElementOfUniverse = elementInSubset;
+    links[elementInUniverse].elementInPreviousSubsetContainingThisElementOfUniverse = elementInSubset;
+
+    if (first_element == HEAD) {
+      links[elementInSubset].nextElement = links[elementInSubset].previousElement = elementInSubset;
+      first_element = elementInSubset;
+    } else {
+      /// The elements of a subset are doubly linked as circular lists (\p previousElement and \p nextElement).
+      links[elementInSubset].nextElement = first_element;
+      links[elementInSubset].previousElement = links[first_element].previousElement;
+      links[links[first_element].previousElement].nextElement = elementInSubset;
+      links[first_element].previousElement = elementInSubset;
+    }
+  }
+
+  if (first_element != HEAD) // At least one element was added to the subset
+  {
+    /// Subsets are indexed in order of definition.
+    universe->nb_subsets++;
+    universe->subsets = realloc (universe->subsets, universe->nb_subsets * sizeof (*universe->subsets));
+    universe->subsets[universe->nb_subsets - 1].name = dlx_universe_subset_name_copy (universe, subset_name, universe->nb_subsets - 1); // The name is stored once for all the elements of the subset.
+    universe->subsets[universe->nb_subsets - 1].node = first_element;
+    universe->subsets[universe->nb_subsets - 1].disabled = 0;
+    universe->subsets[universe->nb_subsets - 1].weight = weight;
+    universe->subsets[universe->nb_subsets - 1].multiplicity = 1;
+    universe->subsets[universe->nb_subsets - 1].priority = 0;
+    dlx_universe_name_table_insert (universe, universe->subsets[universe->nb_subsets - 1].name);
+    if (nb_elements > universe->max_subset_length)
+      universe->max_subset_length = nb_elements;
+    if (universe->subset_table)
+      dlx_universe_subset_table_insert (universe, hash, universe->nb_subsets - 1);
+
+    dlx_universe_symmetry_invalidate (universe);
+  }
+
+  return first_element;
+}
+
+/// Adds a subset to the universe.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the added subset
+/// @param [in] weight Cost of the subset in a solution.
+/// @param [in] nb_elements Number of elements of the universe contained in the subset.
+/// @param [in] elements Names of elements of the universe contained in the subset.
+/// @return 1 if added successfully, 0 otherwise.
+static int
+dlx_universe_subset_define (Universe universe, const char *subset_name, double weight, unsigned long nb_elements, const char *elements[]) {
+  if (!universe || !subset_name || !nb_elements || !elements)
+    return 0;
+
+  DLX_PRINT (universe, "Elements in subset %s:", *subset_name ? subset_name : "(unnamed)");
+  int redo = 0;
+
+  // Elements of the universe contained in the subset.
+  // They are all fetched (or added) first so that the elements of the subset are contiguous in the node storage.
+  unsigned long elementsInUniverse[nb_elements];
+  unsigned long nb_elementsInUniverse = 0;
+
+  for (unsigned long i = 0; i < nb_elements; i++) {
+    if (!elements[i] || !*elements[i])
+      continue;
+
+    DLX_PRINT (universe, " %s", elements[i]);
+    unsigned long elementInUniverse = HEAD;
+
+    if (!universe->unbound) {
+      if ((elementInUniverse = dlx_universe_get_element_by_name (universe, elements[i])) == HEAD) {
+        DLX_PRINT (universe, " (unknown element)");
+        redo = 1;
+        continue;
+      }
+    } else { // if (universe->unbound)
+      dlx_universe_add_element (universe, elements[i]);
+      elementInUniverse = dlx_universe_get_element_by_name (universe, elements[i]);
+    }
+
+    int already_included = 0;
+
+    for (unsigned long j = 0; j < nb_elementsInUniverse && !already_included; j++)
+      if (elementsInUniverse[j] == elementInUniverse)
+        already_included = 1; // element already included in subset
+
+    if (already_included) {
+      DLX_PRINT (universe, " (element already included in subset ==> ignored)");
+      redo = 1;
+      continue;
+    }
+
+    elementsInUniverse[nb_elementsInUniverse++] = elementInUniverse;
+  }
+
+  unsigned long first_element = dlx_universe_subset_add (universe, subset_name, weight, nb_elementsInUniverse, elementsInUniverse);
+
+  if (first_element != HEAD) // At least one element was added to the subset
+  {
+    if (redo) {
+      DLX_PRINT (universe, " =");
+      unsigned long elementInSubset = first_element;
+
+      do {
+        DLX_PRINT (universe, " %s", universe->elements[universe->columns[elementInSubset]].name);
+        elementInSubset = universe->matrix.links[elementInSubset].nextElement;
+      } while (elementInSubset != first_element);
+    }
+
+    DLX_PRINT (universe, "\n");
+    return 1;
+  } else {
+    DLX_PRINT (universe, " (empty subset)\n");
+    return 0;
+  }
+}
+
+int
+dlx_subset_define (Universe universe, const char *subset_name, unsigned long nb_elements, const unsigned long elements[])
+    __attribute__ ((overloadable)) {
+  if (!universe || !subset_name || !nb_elements || !elements)
+    return 0;
+
+  DLX_PRINT (universe, "Elements in subset %s:", *subset_name ? subset_name : "(unnamed)");
+  const struct links *links = universe->matrix.links;
+  unsigned long elementsInUniverse[nb_elements];
+  unsigned long nb_elementsInUniverse = 0;
+
+  for (unsigned long i = 0; i < nb_elements; i++) {
+    if (elements[i] >= universe->nb_elements) {
+      DLX_PRINT (universe, " #%lu (unknown element)", elements[i]);
+      continue;
+    }
+
+    unsigned long elementInUniverse = universe->elements[elements[i]].node;
+
+    DLX_PRINT (universe, " %s", universe->elements[elements[i]].name);
+    // As when elements are given by name, elements covered by subsets required in solutions are unknown.
+    if (!universe->elements[elements[i]].disabled && links[links[elementInUniverse].previousElement].nextElement != elementInUniverse) {
+      DLX_PRINT (universe, " (unknown element)");
+      continue;
+    }
+
+    int already_included = 0;
+
+    for (unsigned long j = 0; j < nb_elementsInUniverse && !already_included; j++)
+      if (elementsInUniverse[j] == elementInUniverse)
+        already_included = 1; // element already included in subset
+
+    if (already_included) {
+      DLX_PRINT (universe, " (element already included in subset ==> ignored)");
+      continue;
+    }
+
+    elementsInUniverse[nb_elementsInUniverse++] = elementInUniverse;
+  }
+
+  int added = dlx_universe_subset_add (universe, subset_name, 1, nb_elementsInUniverse, elementsInUniverse) != HEAD;
+
+  DLX_PRINT (universe, "%s\n", added ? "" : " (empty subset)");
+  return added;
+}
+
+/// Adds a subset to the universe.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the added subset
+/// @param [in] weight Cost of the subset in a solution.
+/// @param [in] some_elements List of elements of the universe contained in the subset, separated by separators.
+/// @param [in] separators List of accepted separators, terminated by \0.
+/// @return 1 if added successfully, 0 otherwise.
+static int
+dlx_universe_subset_define_list (Universe universe, const char *subset_name, double weight, const char *some_elements, const char *separators) {
+  if (!some_elements)
+    return 0;
+
+  char *sccpy;
+  char *saveptr;
+  unsigned long nb_cols;
+
+  sccpy = strdup (some_elements);
+  nb_cols = 0;
+  for (char *c = sccpy; strtok_r (c, separators, &saveptr); c = 0)
+    nb_cols++;
+  free (sccpy);
+
+  if (!nb_cols)
+    return 0;
+
+  const char *cols[nb_cols];
   char *colname;
 
-  sccpy = strdup (elements);
-  nb_cols = 0;
-  for (char *c = sccpy; (colname = strtok_r (c, separators, &saveptr)); c = 0)
-    cols[nb_cols++] = colname;
+  sccpy = strdup (some_elements);
+  nb_cols = 0;
+  for (char *c = sccpy; (colname = strtok_r (c, separators, &saveptr)); c = 0)
+    cols[nb_cols++] = colname;
+
+  int ret = dlx_universe_subset_define (universe, subset_name, weight, nb_cols, cols);
+
+  free (sccpy);
+
+  return ret;
+}
+
+int
+dlx_subset_define (Universe universe, const char *subset_name, unsigned long nb_elements, const char *elements[])
+    __attribute__ ((overloadable)) {
+  return dlx_universe_subset_define (universe, subset_name, 1, nb_elements, elements); // Default weight: the solution of minimal cost has the fewest subsets.
+}
+
+int
+dlx_subset_define (Universe universe, const char *subset_name, const char *some_elements, const char *separators)
+    __attribute__ ((overloadable)) {
+  return dlx_universe_subset_define_list (universe, subset_name, 1, some_elements, separators);
+}
+
+/// Explains why a subset can not be required in solutions.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the subset
+/// @post The conflict of the universe is set.
+///
+/// If several subsets have this name, the conflict of the first enabled one (in order of definition) is reported.
+static void
+dlx_universe_conflict_explain (Universe universe, const char *subset_name) {
+  struct dlx_conflict *conflict = &universe->conflict;
+
+  conflict->reason = DLX_CONFLICT_UNKNOWN_SUBSET;
+  conflict->subset = conflict->element = conflict->required = 0;
+
+  unsigned long hash = dlx_name_hash (subset_name), s = ULONG_MAX;
+
+  for (unsigned long slot = dlx_universe_name_first (universe, subset_name, hash); slot != ULONG_MAX;
+       slot = dlx_universe_name_next (universe, subset_name, hash, slot + 1)) {
+    unsigned long subset = dlx_name_subset (universe->name_table[slot].name);
+
+    if (universe->name_table[slot].disabled || universe->subsets[subset].disabled) {
+      if (s == ULONG_MAX) {
+        conflict->reason = DLX_CONFLICT_DISABLED_SUBSET;
+        conflict->subset = universe->name_table[slot].name;
+      }
+    } else if (subset < s) {
+      s = subset;
+      conflict->subset = universe->name_table[slot].name;
+    }
+  }
+
+  if (s != ULONG_MAX) {
+    // Looks for an element of the subset covered by a subset already required in solutions.
+    unsigned long first = universe->subsets[s].node;
+    unsigned long j = first;
+
+    do {
+      for (unsigned long i = 0; i < universe->nb_required_subsets; i++) {
+        unsigned long required = universe->subsets[universe->required_subsets[i]].node;
+        unsigned long k = required;
+
+        do {
+          if (universe->columns[k] == universe->columns[j]) {
+            conflict->reason = DLX_CONFLICT_ELEMENT_COVERED;
+            conflict->element = universe->elements[universe->columns[j]].name;
+            conflict->required = universe->required_names[i];
+            return;
+          }
+          k = universe->matrix.links[k].nextElement;
+        } while (k != required);
+      }
+      j = universe->matrix.links[j].nextElement;
+    } while (j != first);
+
+    // Otherwise, none of the elements of the subset is to be covered.
+    conflict->reason = DLX_CONFLICT_DISABLED_ELEMENTS;
+  }
+}
+
+int
+dlx_subset_define (Universe universe, const char *subset_name, double weight, unsigned long nb_elements, const char *elements[])
+    __attribute__ ((overloadable)) {
+  // Lower bounds of costs only hold for weights which are not negative.
+  if (!(weight >= 0))
+    return 0;
+
+  return dlx_universe_subset_define (universe, subset_name, weight, nb_elements, elements);
+}
+
+int
+dlx_subset_define (Universe universe, const char *subset_name, double weight, const char *list_of_some_elements, const char *separators)
+    __attribute__ ((overloadable)) {
+  if (!(weight >= 0))
+    return 0;
+
+  return dlx_universe_subset_define_list (universe, subset_name, weight, list_of_some_elements, separators);
+}
+
+int
+dlx_duplicates_merge_set (Universe universe, int merge) {
+  if (!universe)
+    return 0;
+
+  int old = universe->subset_table != 0;
+
+  if (merge && !universe->subset_table) {
+    // Subsets already defined are indexed, so that subsets defined later are merged into them.
+    unsigned long capacity = 64;
+
+    while (capacity < 2 * universe->nb_subsets)
+      capacity *= 2;
+    if (!(universe->subset_table = malloc (capacity * sizeof (*universe->subset_table)))) {
+      DLX_PRINT (universe, "Identical subsets not merged (out of memory).\n");
+      return old;
+    }
+    universe->subset_table_capacity = capacity;
+    for (unsigned long i = 0; i < universe->subset_table_capacity; i++)
+      universe->subset_table[i].subset = ULONG_MAX;
+
+    unsigned long elements[universe->max_subset_length + 1];
+
+    for (unsigned long s = 0; s < universe->nb_subsets; s++)
+      dlx_universe_subset_table_insert (universe, dlx_subset_hash (elements, dlx_universe_subset_elements (universe, s, elements)), s);
+  } else if (!merge && universe->subset_table) {
+    free (universe->subset_table);
+    universe->subset_table = 0;
+    universe->subset_table_capacity = 0;
+  }
+
+  return old;
+}
+
+unsigned long
+dlx_subset_multiplicity (Universe universe, unsigned long subset) {
+  return universe && subset < universe->nb_subsets ? universe->subsets[subset].multiplicity : 0;
+}
+
+/// Checks whether a subset can be required in solutions.
+/// @param [in] universe Universe
+/// @param [in] subset Index of an enabled subset
+/// @return 1 if none of the elements of the subset is covered by the subsets required in solutions and one of them is enabled, 0 otherwise.
+///
+/// Elements, disabled or not, are removed from the list of elements of the universe when they are covered.
+static int
+dlx_universe_subset_requirable (const struct universe *universe, unsigned long subset) {
+  const struct links *links = universe->matrix.links;
+  unsigned long first = universe->subsets[subset].node;
+  unsigned long j = first;
+  int enabled = 0;
+
+  do {
+    unsigned long elementInUniverse = universe->elements[universe->columns[j]].node;
+
+    if (links[links[elementInUniverse].previousElement].nextElement != elementInUniverse)
+      return 0;
+    if (!universe->elements[universe->columns[j]].disabled)
+      enabled = 1;
+    j = links[j].nextElement;
+  } while (j != first);
+
+  return enabled;
+}
+
+int
+dlx_subset_require_in_solution (Universe universe, const char *subset_name) {
+  if (!universe || !subset_name)
+    return 0;
+
+  struct links *links = universe->matrix.links;
+
+  DLX_PRINT (universe, "Subset required in solution:\n");
+  DLX_PRINT (universe, "  [%lu]\tSubset %s:", universe->nb_required_subsets + 1, subset_name);
+
+  unsigned long hash = dlx_name_hash (subset_name), subset = ULONG_MAX;
+  const char *name = 0;
+
+  // In case of several candidate subsets (with the same name), the first one in order of definition is chosen.
+  // Subsets merged into an identical subset are found by their own names, and require the identical subset.
+  for (unsigned long slot = dlx_universe_name_first (universe, subset_name, hash); slot != ULONG_MAX;
+       slot = dlx_universe_name_next (universe, subset_name, hash, slot + 1)) {
+    unsigned long s = dlx_name_subset (universe->name_table[slot].name);
+
+    if (s < subset && !universe->name_table[slot].disabled && !universe->subsets[s].disabled && dlx_universe_subset_requirable (universe, s)) {
+      subset = s;
+      name = universe->name_table[slot].name;
+    }
+  }
+
+  if (subset != ULONG_MAX) {
+    unsigned long first = universe->subsets[subset].node;
+    unsigned long j = first;
+
+    // Removes the elements contained in the required subset
+    // and all the subsets which contain these elements, the required subset included.
+    do {
+      DLX_PRINT (universe, " %s", universe->elements[universe->columns[j]].name); // Name of the element.
+
+      // This subset containing element might also contain elements which are
+      // de facto included in the solution.
+      // We can therefore remove these elements from the universe.
+
+      // Furthermore, the solution can not contain subsets that
+      // contain this element, otherwise,
+      // there would be more than one subset containing this element in the solution.
+      // Thus, those elements can be removed from the universe.
+
+      dlx_element_cover (&universe->matrix, universe->columns, universe->elements[universe->columns[j]].node);
+
+      // Keep a reference to the uncovered element for further access.
+      universe->uncover_column_length++;
+      universe->uncover_column = realloc (universe->uncover_column, universe->uncover_column_length * sizeof (*universe->uncover_column));
+      universe->uncover_column[universe->uncover_column_length - 1] = universe->elements[universe->columns[j]].node;
+
+      j = links[j].nextElement;
+    } while (j != first);
+
+    DLX_PRINT (universe, "\n");
+
+    universe->nb_required_subsets++;
+    universe->required_subsets = realloc (universe->required_subsets, universe->nb_required_subsets * sizeof (*universe->required_subsets));
+    universe->required_subsets[universe->nb_required_subsets - 1] = subset;
+    universe->required_names = realloc (universe->required_names, universe->nb_required_subsets * sizeof (*universe->required_names));
+    universe->required_names[universe->nb_required_subsets - 1] = name;
+
+    universe->conflict.reason = DLX_CONFLICT_NONE;
+    universe->conflict.subset = name;
+    universe->conflict.element = universe->conflict.required = 0;
+
+    dlx_universe_symmetry_invalidate (universe);
+
+    return 1;
+  }
+
+  // The required subset can not be part of the solution : either it's unknown by name, or it is not
+  // compatible with other subsets already included in a required solution.
+  dlx_universe_conflict_explain (universe, subset_name);
+
+  switch (universe->conflict.reason) {
+    case DLX_CONFLICT_ELEMENT_COVERED:
+      DLX_PRINT (universe, " (element %s already covered by required subset %s ==> not required in solutions)\n", universe->conflict.element,
+                 universe->conflict.required);
+      break;
+    case DLX_CONFLICT_DISABLED_SUBSET:
+      DLX_PRINT (universe, " (disabled subset ==> not required in solutions)\n");
+      break;
+    case DLX_CONFLICT_DISABLED_ELEMENTS:
+      DLX_PRINT (universe, " (subset of disabled elements ==> not required in solutions)\n");
+      break;
+    default:
+      DLX_PRINT (universe, " (unknown subset ==> not required in solutions)\n");
+      break;
+  }
+
+  return 0;
+}
+
+const struct dlx_conflict *
+dlx_assumption_conflict (Universe universe) {
+  return universe ? &universe->conflict : 0;
+}
+
+unsigned long
+dlx_assumption_push (Universe universe) {
+  if (!universe)
+    return 0;
+
+  universe->nb_assumptions++;
+  universe->assumptions = realloc (universe->assumptions, universe->nb_assumptions * sizeof (*universe->assumptions));
+  universe->assumptions[universe->nb_assumptions - 1] = universe->nb_required_subsets;
+
+  DLX_PRINT (universe, "Assumptions: level %lu pushed.\n", universe->nb_assumptions);
+
+  return universe->nb_assumptions;
+}
+
+int
+dlx_assumption_pop (Universe universe) {
+  if (!universe || !universe->nb_assumptions)
+    return 0;
+
+  unsigned long nb_required = universe->assumptions[--universe->nb_assumptions];
+
+  DLX_PRINT (universe, "Assumptions: level %lu popped (%lu required subset(s) released).\n", universe->nb_assumptions + 1,
+             universe->nb_required_subsets - nb_required);
+
+  if (universe->nb_required_subsets == nb_required)
+    return 1;
+
+  // The subsets required since the level was pushed are released in reverse order, by uncovering the elements they covered:
+  // the other subsets required in solutions are left untouched.
+  while (universe->nb_required_subsets > nb_required) {
+    unsigned long first = universe->subsets[universe->required_subsets[--universe->nb_required_subsets]].node;
+    unsigned long j = first;
+
+    do {
+      dlx_element_uncover (&universe->matrix, universe->columns, universe->uncover_column[--universe->uncover_column_length]);
+      j = universe->matrix.links[j].nextElement;
+    } while (j != first);
+  }
+
+  dlx_universe_symmetry_invalidate (universe);
+
+  return 1;
+}
+
+/// Enables or disables a subset, given by its index.
+/// @param [in] universe Universe
+/// @param [in] subset Index of the subset
+/// @param [in] disabled 1 to disable the subset, 0 to enable it.
+/// @return 1 if the subset was modified, 0 otherwise (a subset required in solutions can not be disabled.)
+///
+/// A disabled subset is only marked as such, in constant time: it is left in the lists of subsets containing its elements of the universe,
+/// so that the elements covered by the subsets required in solutions are left as they are, and searches explore the subsets in the same order
+/// as if it had never been disabled. It is removed from the links of search contexts when they are created.
+static int
+dlx_universe_subset_state_set (Universe universe, unsigned long subset, int disabled) {
+  if (universe->subsets[subset].disabled == disabled)
+    return 0;
+
+  for (unsigned long i = 0; disabled && i < universe->nb_required_subsets; i++)
+    if (universe->required_subsets[i] == subset)
+      return 0;
+
+  universe->subsets[subset].disabled = disabled;
+
+  return 1;
+}
+
+/// Enables or disables the subsets with a given name.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the subsets
+/// @param [in] disabled 1 to disable the subsets, 0 to enable them.
+/// @return 1 if at least one subset was modified, 0 otherwise.
+static int
+dlx_subset_state_set (Universe universe, const char *subset_name, int disabled) {
+  if (!universe || !subset_name)
+    return 0;
+
+  int modified = 0;
+  unsigned long hash = dlx_name_hash (subset_name);
+
+  for (unsigned long slot = dlx_universe_name_first (universe, subset_name, hash); slot != ULONG_MAX;
+       slot = dlx_universe_name_next (universe, subset_name, hash, slot + 1)) {
+    struct name_slot *name = &universe->name_table[slot];
+    unsigned long s = dlx_name_subset (name->name);
+
+    // A subset merged into an identical subset is disabled on its own: the multiplicity of the identical subset is decremented,
+    // and incremented again when it is enabled.
+    if (dlx_universe_name_merged (universe, slot)) {
+      if (name->disabled != disabled) {
+        name->disabled = disabled;
+        if (disabled) {
+          universe->subsets[s].multiplicity--;
+          universe->nb_duplicates--;
+        } else {
+          universe->subsets[s].multiplicity++;
+          universe->nb_duplicates++;
+        }
+        modified = 1;
+      }
+    } else if (dlx_universe_subset_state_set (universe, s, disabled))
+      modified = 1;
+  }
+
+  DLX_PRINT (universe, "Subset %s %s%s.\n", *subset_name ? subset_name : "(unnamed)", disabled ? "disabled" : "enabled",
+             modified ? "" : " (unknown, required or unchanged subset ==> ignored)");
+
+  if (modified)
+    dlx_universe_symmetry_invalidate (universe);
+
+  return modified;
+}
+
+/// Enables or disables a subset, given by its index, on behalf of the user.
+/// @param [in] universe Universe
+/// @param [in] subset Index of the subset
+/// @param [in] disabled 1 to disable the subset, 0 to enable it.
+/// @return 1 if the subset was modified, 0 otherwise.
+static int
+dlx_subset_index_state_set (Universe universe, unsigned long subset, int disabled) {
+  if (!universe)
+    return 0;
+
+  int modified = subset < universe->nb_subsets && dlx_universe_subset_state_set (universe, subset, disabled);
+
+  DLX_PRINT (universe, "Subset #%lu %s%s.\n", subset, disabled ? "disabled" : "enabled",
+             modified ? "" : " (unknown, required or unchanged subset ==> ignored)");
+
+  if (modified)
+    dlx_universe_symmetry_invalidate (universe);
+
+  return modified;
+}
+
+int
+dlx_subset_disable (Universe universe, const char *subset_name) __attribute__ ((overloadable)) {
+  return dlx_subset_state_set (universe, subset_name, 1);
+}
+
+int
+dlx_subset_disable (Universe universe, unsigned long subset) __attribute__ ((overloadable)) {
+  return dlx_subset_index_state_set (universe, subset, 1);
+}
+
+int
+dlx_subset_enable (Universe universe, const char *subset_name) __attribute__ ((overloadable)) {
+  return dlx_subset_state_set (universe, subset_name, 0);
+}
+
+int
+dlx_subset_enable (Universe universe, unsigned long subset) __attribute__ ((overloadable)) {
+  return dlx_subset_index_state_set (universe, subset, 0);
+}
+
+/// Enables or disables an element of the universe, given by its index.
+/// @param [in] universe Universe
+/// @param [in] index Index of the element of the universe
+/// @param [in] disabled 1 to disable the element, 0 to enable it.
+/// @return 1 if the element was modified, 0 otherwise.
+///
+/// A disabled element is only marked as such, in constant time: it is left in the list of elements of the universe and subsets containing it are kept.
+/// It is removed from the list of elements of search contexts when they are created.
+static int
+dlx_universe_element_state_set (Universe universe, unsigned long index, int disabled) {
+  if (universe->elements[index].disabled == disabled)
+    return 0;
+
+  universe->elements[index].disabled = disabled;
+
+  return 1;
+}
+
+/// Enables or disables an element of the universe.
+/// @param [in] universe Universe
+/// @param [in] element_name Name of the element
+/// @param [in] disabled 1 to disable the element, 0 to enable it.
+/// @return 1 if the element was modified, 0 otherwise.
+static int
+dlx_element_state_set (Universe universe, const char *element_name, int disabled) {
+  if (!universe || !element_name)
+    return 0;
+
+  unsigned long element = dlx_universe_get_element_by_name (universe, element_name);
+  int modified = element != HEAD && dlx_universe_element_state_set (universe, universe->columns[element], disabled);
+
+  DLX_PRINT (universe, "Element %s %s%s.\n", element_name, disabled ? "disabled" : "enabled", modified ? "" : " (unknown or unchanged element ==> ignored)");
+
+  if (modified)
+    dlx_universe_symmetry_invalidate (universe);
+
+  return modified;
+}
+
+/// Enables or disables an element of the universe, given by its index, on behalf of the user.
+/// @param [in] universe Universe
+/// @param [in] element Index of the element of the universe
+/// @param [in] disabled 1 to disable the element, 0 to enable it.
+/// @return 1 if the element was modified, 0 otherwise.
+static int
+dlx_element_index_state_set (Universe universe, unsigned long element, int disabled) {
+  if (!universe)
+    return 0;
+
+  int modified = element < universe->nb_elements && dlx_universe_element_state_set (universe, element, disabled);
+
+  DLX_PRINT (universe, "Element #%lu %s%s.\n", element, disabled ? "disabled" : "enabled", modified ? "" : " (unknown or unchanged element ==> ignored)");
+
+  if (modified)
+    dlx_universe_symmetry_invalidate (universe);
+
+  return modified;
+}
+
+int
+dlx_element_disable (Universe universe, const char *element_name) __attribute__ ((overloadable)) {
+  return dlx_element_state_set (universe, element_name, 1);
+}
+
+int
+dlx_element_disable (Universe universe, unsigned long element) __attribute__ ((overloadable)) {
+  return dlx_element_index_state_set (universe, element, 1);
+}
+
+int
+dlx_element_enable (Universe universe, const char *element_name) __attribute__ ((overloadable)) {
+  return dlx_element_state_set (universe, element_name, 0);
+}
+
+int
+dlx_element_enable (Universe universe, unsigned long element) __attribute__ ((overloadable)) {
+  return dlx_element_index_state_set (universe, element, 0);
+}
+
+int
+dlx_subset_unrequire_in_solution (Universe universe, const char *subset_name) {
+  if (!universe || !subset_name)
+    return 0;
+
+  unsigned long last = universe->nb_required_subsets;
+  int released = last && !strcmp (universe->required_names[last - 1], subset_name);
+
+  // Only the last subset required in solutions is released, by uncovering the elements it covered in reverse order, as dlx_assumption_pop() does:
+  // the elements covered by the other subsets required in solutions are left untouched.
+  DLX_PRINT (universe, "Subset %s no longer required in solution%s.\n", *subset_name ? subset_name : "(unnamed)",
+             released ? "" : " (not the last subset required ==> ignored)");
+
+  if (!released)
+    return 0;
+
+  unsigned long first = universe->subsets[universe->required_subsets[--universe->nb_required_subsets]].node;
+  unsigned long j = first;
+
+  do {
+    dlx_element_uncover (&universe->matrix, universe->columns, universe->uncover_column[--universe->uncover_column_length]);
+    j = universe->matrix.links[j].nextElement;
+  } while (j != first);
+
+  // Levels of assumptions pushed after the released subset was required hold one subset less.
+  for (unsigned long a = 0; a < universe->nb_assumptions; a++)
+    if (universe->assumptions[a] > universe->nb_required_subsets)
+      universe->assumptions[a] = universe->nb_required_subsets;
+
+  dlx_universe_symmetry_invalidate (universe);
+
+  return 1;
+}
+
+int
+dlx_symmetry_define (Universe universe, unsigned long nb_elements, const unsigned long images[]) __attribute__ ((overloadable)) {
+  if (!universe || !images || nb_elements != universe->nb_elements || !nb_elements)
+    return 0;
+
+  DLX_PRINT (universe, "Symmetry:");
+
+  // The images must be a permutation of the elements of the universe.
+  char *reached = calloc (nb_elements, sizeof (*reached));
+  unsigned long e;
+
+  for (e = 0; e < nb_elements && images[e] < nb_elements && !reached[images[e]]; e++)
+    reached[images[e]] = 1;
+  free (reached);
+
+  if (e < nb_elements) {
+    DLX_PRINT (universe, " (not a permutation of the elements of the universe ==> ignored)\n");
+    return 0;
+  }
+
+  for (e = 0; e < nb_elements; e++)
+    if (images[e] != e)
+      DLX_PRINT (universe, " %s->%s", universe->elements[e].name, universe->elements[images[e]].name);
+
+  // The permutation must map subsets on subsets.
+  struct subset_key *keys = dlx_universe_subset_keys (universe);
+  int automorphism = dlx_permutation_map_subsets (keys, universe->nb_subsets, images, 0);
+
+  dlx_subset_keys_free (keys, universe->nb_subsets);
+
+  if (!automorphism) {
+    DLX_PRINT (universe, " (does not map subsets on subsets ==> ignored)\n");
+    return 0;
+  }
+
+  DLX_PRINT (universe, "\n");
+
+  if (!universe->symmetry)
+    universe->symmetry = calloc (1, sizeof (*universe->symmetry));
+
+  struct symmetry *symmetry = universe->symmetry;
+
+  symmetry->generators = realloc (symmetry->generators, (symmetry->nb_generators + 1) * sizeof (*symmetry->generators));
+  symmetry->generators[symmetry->nb_generators] = malloc (nb_elements * sizeof (**symmetry->generators));
+  memcpy (symmetry->generators[symmetry->nb_generators], images, nb_elements * sizeof (**symmetry->generators));
+  symmetry->nb_generators++;
+
+  dlx_universe_symmetry_invalidate (universe);
+
+  return 1;
+}
+
+int
+dlx_symmetry_define (Universe universe, unsigned long nb_elements, const char *elements[], const char *images[]) __attribute__ ((overloadable)) {
+  if (!universe || !universe->nb_elements || !elements || !images)
+    return 0;
+
+  unsigned long permutation[universe->nb_elements];
+
+  for (unsigned long e = 0; e < universe->nb_elements; e++)
+    permutation[e] = e;
+
+  for (unsigned long i = 0; i < nb_elements; i++) {
+    unsigned long element = elements[i] ? dlx_universe_get_element_by_name (universe, elements[i]) : HEAD;
+    unsigned long image = images[i] ? dlx_universe_get_element_by_name (universe, images[i]) : HEAD;
+
+    if (element == HEAD || image == HEAD) {
+      DLX_PRINT (universe, "Symmetry: %s->%s (unknown element ==> ignored)\n", elements[i] ? elements[i] : "(null)", images[i] ? images[i] : "(null)");
+      return 0;
+    }
+
+    permutation[universe->columns[element]] = universe->columns[image];
+  }
+
+  /// @overload
+  return dlx_symmetry_define (universe, universe->nb_elements, (const unsigned long *)permutation);
+}
+
+/// Duplicates an array.
+/// @param [in] array Array to be duplicated (can be 0.)
+/// @param [in] size Size of the array, in bytes.
+/// @return Copy of the array (0 if \p array is 0.)
+static void *
+dlx_array_copy (const void *array, size_t size) {
+  return array ? memcpy (malloc (size ? size : 1), array, size) : 0;
+}
+
+Universe
+dlx_universe_clone (const struct universe *universe) {
+  if (!universe)
+    return 0;
+
+  Universe clone = malloc (sizeof (*clone));
+
+  // Elements refer to each other by their indices in the node storage: the node storage and the links are copied as such.
+  *clone = *universe;
+  clone->nodes_capacity = universe->nb_nodes;
+  clone->columns = dlx_array_copy (universe->columns, universe->nb_nodes * sizeof (*universe->columns));
+  clone->rows = dlx_array_copy (universe->rows, universe->nb_nodes * sizeof (*universe->rows));
+  clone->matrix.links = dlx_array_copy (universe->matrix.links, universe->nb_nodes * sizeof (*universe->matrix.links));
+  clone->matrix.size = dlx_array_copy (universe->matrix.size, universe->nb_elements * sizeof (*universe->matrix.size));
+
+  // Names are shared by reference.
+  clone->name_pools = dlx_array_copy (universe->name_pools, universe->nb_name_pools * sizeof (*universe->name_pools));
+  for (unsigned long i = 0; i < universe->nb_name_pools; i++)
+    __atomic_add_fetch (&universe->name_pools[i]->references, 1, __ATOMIC_ACQ_REL);
+
+  clone->uncover_column = dlx_array_copy (universe->uncover_column, universe->uncover_column_length * sizeof (*universe->uncover_column));
+  clone->required_subsets = dlx_array_copy (universe->required_subsets, universe->nb_required_subsets * sizeof (*universe->required_subsets));
+  clone->required_names = dlx_array_copy (universe->required_names, universe->nb_required_subsets * sizeof (*universe->required_names));
+  clone->assumptions = dlx_array_copy (universe->assumptions, universe->nb_assumptions * sizeof (*universe->assumptions));
+  clone->elements = dlx_array_copy (universe->elements, universe->nb_elements * sizeof (*universe->elements));
+  clone->subsets = dlx_array_copy (universe->subsets, universe->nb_subsets * sizeof (*universe->subsets));
+  clone->subset_table = dlx_array_copy (universe->subset_table, universe->subset_table_capacity * sizeof (*universe->subset_table));
+  clone->name_table = dlx_array_copy (universe->name_table, universe->name_table_capacity * sizeof (*universe->name_table));
+
+  // Declared symmetries are copied, the group of symmetries will be computed again if needed.
+  if (universe->symmetry) {
+    clone->symmetry = calloc (1, sizeof (*clone->symmetry));
+    clone->symmetry->nb_generators = universe->symmetry->nb_generators;
+    clone->symmetry->generators = malloc (universe->symmetry->nb_generators * sizeof (*clone->symmetry->generators));
+    for (unsigned long i = 0; i < universe->symmetry->nb_generators; i++)
+      clone->symmetry->generators[i] = dlx_array_copy (universe->symmetry->generators[i], universe->nb_elements * sizeof (**universe->symmetry->generators));
+  }
+
+  return clone;
+}
+
+#ifdef __linux__
+/// Gets the size of huge pages, as reported by the system.
+/// @param [in] explicit 1 for reserved huge pages, 0 for transparent huge pages.
+/// @return Size of huge pages, in bytes (\p DLX_HUGE_PAGE_SIZE if the system does not report it.)
+///
+/// The sizes are read once, from \p /sys/kernel/mm/transparent_hugepage/hpage_pmd_size and \p Hugepagesize in \p /proc/meminfo.
+static unsigned long
+dlx_huge_page_size (int explicit) {
+  static unsigned long sizes[2];
+  unsigned long size = __atomic_load_n (&sizes[explicit], __ATOMIC_RELAXED);
+
+  if (size)
+    return size;
+
+  FILE *file;
+
+  if (!explicit && (file = fopen ("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r"))) {
+    if (fscanf (file, "%lu", &size) != 1)
+      size = 0;
+    fclose (file);
+  }
+  if (!size && (file = fopen ("/proc/meminfo", "r"))) {
+    char line[128];
+    unsigned long kilobytes;
+
+    while (fgets (line, sizeof (line), file))
+      if (sscanf (line, "Hugepagesize: %lu kB", &kilobytes) == 1) {
+        size = kilobytes * 1024;
+        break;
+      }
+    fclose (file);
+  }
+  // Mappings are rounded up to a multiple of the size, which must therefore be a power of 2.
+  if (!size || (size & (size - 1)))
+    size = DLX_HUGE_PAGE_SIZE;
+
+  __atomic_store_n (&sizes[explicit], size, __ATOMIC_RELAXED);
+  return size;
+}
+#endif
+
+/// Removes the disabled subsets and elements from the links of a search context.
+/// @param [in] context Search context, with a copy of the links of its universe.
+///
+/// Disabled subsets are left in the links of the universe: those which are not removed already (by the subsets required in solutions)
+/// are removed from the lists of subsets containing their elements, in O(number of elements of disabled subsets).
+/// Disabled elements left to be covered are removed from the list of elements, and linked to themselves,
+/// so that covering and uncovering them during the search leave the list unchanged.
+/// Elements covered by the subsets required in solutions are never uncovered in search contexts: they are left as they are.
+static void
+dlx_search_context_unlink_disabled (SearchContext context) {
+  const struct universe *universe = context->universe;
+  struct links *links = context->matrix.links;
+
+  for (unsigned long s = 0; s < universe->nb_subsets; s++) {
+    if (!universe->subsets[s].disabled)
+      continue;
+
+    unsigned long first = universe->subsets[s].node;
+    unsigned long j = first;
+    int removed = 0;
+
+    do {
+      unsigned long elementInUniverse = universe->elements[universe->columns[j]].node;
+
+      removed |= links[links[elementInUniverse].previousElement].nextElement != elementInUniverse;
+      j = links[j].nextElement;
+    } while (j != first);
+
+    if (removed)
+      continue;
+
+    do {
+      links[links[j].elementInPreviousSubsetContainingThisElementOfUniverse].elementInNextSubsetContainingThisElementOfUniverse =
+          links[j].elementInNextSubsetContainingThisElementOfUniverse;
+      links[links[j].elementInNextSubsetContainingThisElementOfUniverse].elementInPreviousSubsetContainingThisElementOfUniverse =
+          links[j].elementInPreviousSubsetContainingThisElementOfUniverse;
+      context->matrix.size[universe->columns[j]]--;
+      j = links[j].nextElement;
+    } while (j != first);
+  }
+
+  for (unsigned long i = 0; i < universe->nb_elements; i++) {
+    unsigned long element = universe->elements[i].node;
+
+    if (universe->elements[i].disabled && links[links[element].previousElement].nextElement == element) {
+      links[links[element].previousElement].nextElement = links[element].nextElement;
+      links[links[element].nextElement].previousElement = links[element].previousElement;
+      links[element].previousElement = links[element].nextElement = element;
+    }
+  }
+}
+
+/// Allocates the links of a search context, according to the memory policy of its universe.
+/// @param [in] context Search context
+///
+/// With a memory policy, the links between elements and the numbers of subsets containing elements are mapped together,
+/// and the policy is applied to the mapping before it is written to, so that its pages are faulted in accordingly.
+static void
+dlx_search_context_allocate (SearchContext context) {
+  const struct universe *universe = context->universe;
+  size_t links_length = universe->nb_nodes * sizeof (*context->matrix.links);
+  size_t length = links_length + universe->nb_elements * sizeof (*context->matrix.size);
+  int policy = universe->memory_policy;
+
+  context->memory_length = 0;
+  context->memory.bytes = length;
+  context->memory.policy = DLX_MEMORY_DEFAULT;
+
+#ifdef __linux__
+  if (policy) {
+    void *memory = MAP_FAILED;
+
+    if (policy & (DLX_MEMORY_HUGE_PAGES | DLX_MEMORY_EXPLICIT_HUGE_PAGES)) {
+      unsigned long huge_page_size = dlx_huge_page_size (!!(policy & DLX_MEMORY_EXPLICIT_HUGE_PAGES));
+
+      length = (length + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+#ifdef MAP_HUGETLB
+    if (policy & DLX_MEMORY_EXPLICIT_HUGE_PAGES)
+      memory = mmap (0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (memory != MAP_FAILED)
+      context->memory.policy |= DLX_MEMORY_EXPLICIT_HUGE_PAGES;
+    else if ((memory = mmap (0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) != MAP_FAILED) {
+      // Transparent huge pages are used in place of reserved huge pages if none is left.
+#ifdef MADV_HUGEPAGE
+      if ((policy & (DLX_MEMORY_HUGE_PAGES | DLX_MEMORY_EXPLICIT_HUGE_PAGES)) && !madvise (memory, length, MADV_HUGEPAGE))
+        context->memory.policy |= DLX_MEMORY_HUGE_PAGES;
+#endif
+    }
+
+    if (memory != MAP_FAILED) {
+#ifdef SYS_mbind
+      // Interleaving is requested over all the nodes (the system restricts it to the nodes allowed.)
+      unsigned long nodes = ~0UL;
+
+      if ((policy & DLX_MEMORY_INTERLEAVE) &&
+          !syscall (SYS_mbind, memory, length, MPOL_INTERLEAVE, &nodes, sizeof (nodes) * CHAR_BIT + 1, 0))
+        context->memory.policy |= DLX_MEMORY_INTERLEAVE;
+      else if ((policy & DLX_MEMORY_LOCAL) && !syscall (SYS_mbind, memory, length, MPOL_LOCAL, 0, 0, 0))
+        context->memory.policy |= DLX_MEMORY_LOCAL;
+#endif
+      context->memory_length = length;
+      context->matrix.links = memory;
+      context->matrix.size = (unsigned long *)((char *)memory + links_length);
+      return;
+    }
+  }
+#else
+  (void)policy;
+#endif
+
+  context->matrix.links = malloc (links_length);
+  context->matrix.size = malloc (universe->nb_elements * sizeof (*context->matrix.size));
+}
+
+SearchContext
+dlx_search_context_create (const struct universe *universe) {
+  if (!universe)
+    return 0;
+
+  SearchContext context = malloc (sizeof (*context));
+
+  context->universe = universe;
+
+  // The links are the only part of the universe modified by a search: the search context works on its own copy of them.
+  unsigned long faults = dlx_memory_faults ();
+
+  dlx_search_context_allocate (context);
+  memcpy (context->matrix.links, universe->matrix.links, universe->nb_nodes * sizeof (*context->matrix.links));
+  if (universe->nb_elements)
+    memcpy (context->matrix.size, universe->matrix.size, universe->nb_elements * sizeof (*context->matrix.size));
+  dlx_search_context_unlink_disabled (context);
+  context->matrix.updates = 0;
+  context->memory.creation_faults = dlx_memory_faults () - faults;
+  context->memory.search_faults = 0;
+  context->memory_stale = 1;
+
+  context->solutions = calloc (universe->nb_subsets - universe->nb_required_subsets + 1, sizeof (*context->solutions));
+  context->solution = calloc (universe->nb_subsets + 1, sizeof (*context->solution));
+  for (unsigned long i = 0; i < universe->nb_required_subsets; i++)
+    context->solution[i] = universe->subsets[universe->required_subsets[i]].name;
+
+  context->solution_displayer = universe->solution_displayer;
+  context->solution_displayer_data = universe->solution_displayer_data;
+  context->trace = universe->trace;
+  context->propagation = universe->propagation;
+  context->nb_forced = context->nb_dead_ends = context->nb_path_forced = 0;
+  context->share = context->path_cost = 0;
+  context->best = 0;
+  context->best_length = 0;
+  context->best_cost = HUGE_VAL;
+  context->max_length = universe->max_length;
+  context->deepening = 0;
+  context->sink = universe->sink;
+  context->engine = universe->engine;
+  context->subset_order = universe->subset_order;
+  context->reordered = 0;
+  context->failures = 0;
+  context->nogoods = 0;
+  context->nogoods_active = 0;
+  memset (&context->nogood_statistics, 0, sizeof (context->nogood_statistics));
+  context->calibration_nodes = universe->calibration_nodes;
+  memset (&context->choice, 0, sizeof (context->choice));
+  memset (&context->calibrated, 0, sizeof (context->calibrated));
+  context->calibrated_fingerprint = 0;
+  context->calibrated_one_only = 0;
+  context->calibrated_cells = 0;
+  context->node_limit = ULONG_MAX;
+  context->event_handler = 0;
+  context->event_data = 0;
+
+  // The group of symmetries is shared with the universe if it is up to date, computed for this search context otherwise.
+  context->symmetry = context->own_symmetry = 0;
+  context->canonical = context->image = 0;
+  if (universe->symmetry) {
+    if (!(context->symmetry = universe->symmetry->group))
+      context->symmetry = context->own_symmetry = dlx_universe_symmetry_group (universe, context->trace);
+
+    unsigned long max_length = universe->nb_subsets - universe->nb_required_subsets;
+
+    context->canonical = malloc ((max_length + 1) * sizeof (*context->canonical));
+    context->image = malloc (((max_length > context->symmetry->group_size ? max_length : context->symmetry->group_size) + 1) * sizeof (*context->image));
+  }
+  context->root_subset = context->root_weight = 0;
+
+  context->nb_solutions_total = 0;
+  context->nb_solutions = 0;
+  context->nb_nodes = 0;
+
+  context->checkpoint_file = 0;
+  context->checkpoint_interval = 0;
+  context->checkpoint_requested = context->stop_requested = 0;
+  context->interrupted = 0;
+  context->resume_path = 0;
+  context->resume_length = 0;
+  context->resume_complete = 0;
+  context->prefix_length = 0;
+
+  context->split_depth = ULONG_MAX;
+  context->split_name = 0;
+  context->nb_jobs = 0;
+  context->result = 0;
+
+  context->next_poll = ULONG_MAX;
+  context->next_checkpoint = 0;
+  context->progress_reporter = 0;
+  context->progress_data = 0;
+  context->progress_interval = context->progress_milliseconds = 0;
+  context->next_progress = 0;
+  context->next_progress_time = 0;
+  context->progress_levels = 0;
+
+  context->sampling_probes = DLX_SAMPLING_PROBES;
+  context->sampling_exact_nodes = DLX_SAMPLING_EXACT_NODES;
+  context->sampling_exact_level = 0;
+  context->random_state = 1;
+  context->sample = 0;
+  memset (&context->sampling_quality, 0, sizeof (context->sampling_quality));
+
+  return context;
+}
+
+void
+dlx_search_context_destroy (SearchContext context) {
+  if (!context)
+    return;
+
+  if (context->memory_length)
+    munmap (context->matrix.links, context->memory_length);
+  else {
+    free (context->matrix.links);
+    free (context->matrix.size);
+  }
+  free (context->solutions);
+  free (context->solution);
+  dlx_symmetry_group_free (context->own_symmetry);
+  free (context->canonical);
+  free (context->image);
+  free (context->checkpoint_file);
+  free (context->resume_path);
+  free (context->sample);
+  free (context->failures);
+  dlx_nogoods_set (context, 0);
+  free (context);
+}
+
+unsigned long
+dlx_solutions_total (Universe universe) __attribute__ ((overloadable)) {
+  return universe ? universe->nb_solutions_total : 0;
+}
+
+unsigned long
+dlx_solutions_total (SearchContext context) __attribute__ ((overloadable)) {
+  return context ? context->nb_solutions_total : 0;
+}
+
+int
+dlx_propagation_set (Universe universe, int propagation) __attribute__ ((overloadable)) {
+  int old = universe->propagation;
+
+  universe->propagation = propagation;
+  return old;
+}
+
+int
+dlx_propagation_set (SearchContext context, int propagation) __attribute__ ((overloadable)) {
+  int old = context->propagation;
+
+  context->propagation = propagation;
+  return old;
+}
+
+unsigned long
+dlx_propagation_forced (Universe universe) __attribute__ ((overloadable)) {
+  return universe ? universe->nb_forced : 0;
+}
+
+unsigned long
+dlx_propagation_forced (SearchContext context) __attribute__ ((overloadable)) {
+  return context ? context->nb_forced : 0;
+}
+
+unsigned long
+dlx_propagation_dead_ends (Universe universe) __attribute__ ((overloadable)) {
+  return universe ? universe->nb_dead_ends : 0;
+}
+
+unsigned long
+dlx_propagation_dead_ends (SearchContext context) __attribute__ ((overloadable)) {
+  return context ? context->nb_dead_ends : 0;
+}
+
+unsigned long
+dlx_exact_cover_search (SearchContext context, int one_only) __attribute__ ((overloadable)) {
+  if (!context)
+    return 0;
+
+  int resuming = context->resume_length || context->resume_complete;
+
+  DLX_PRINT (context, "%s for %s exact cover solution%s.\n", resuming ? "Resuming search" : "Searching", one_only ? "the first" : "all", one_only ? "" : "s");
+
+  if (context->engine == DLX_ENGINE_AUTO)
+    dlx_search_auto_select (context, resuming, one_only);
+
+  // Counters are restored from the checkpoint when resuming.
+  if (!resuming)
+    context->nb_solutions_total = context->nb_solutions = context->nb_nodes = context->matrix.updates = 0;
+  context->nb_forced = context->nb_dead_ends = context->nb_path_forced = 0;
+  context->interrupted = 0;
+
+  context->next_checkpoint = context->nb_nodes + context->checkpoint_interval;
+  context->next_progress = context->nb_nodes + context->progress_interval;
+  context->next_progress_time = context->progress_milliseconds ? dlx_clock_milliseconds () + context->progress_milliseconds : 0;
+  dlx_search_schedule (context);
+
+  if (!context->resume_complete)
+    dlx_search_root (context, one_only);
+  context->resume_length = 0;
+  context->resume_complete = 0;
+  context->prefix_length = 0;
+  context->stop_requested = 0;
+
+  unsigned long nb_solutions = context->nb_solutions;
+
+  if (context->interrupted) {
+    DLX_PRINT (context, "Search stopped after %lu node%s.\n", context->nb_nodes, context->nb_nodes == 1 ? "" : "s");
+    return nb_solutions;
+  }
+
+  if (!nb_solutions && !context->result && !context->deepening) // In case no solutions were found.
+    DLX_DISPLAY_SOLUTION (context, 0, 0);
+
+  if (context->symmetry && context->symmetry->group_size > 1)
+    DLX_PRINT (context, "%lu solution%s found, symmetric images included.\n", context->nb_solutions_total, context->nb_solutions_total == 1 ? "" : "s");
+  if (context->universe->nb_duplicates)
+    DLX_PRINT (context, "%lu solution%s found, merged identical subsets included.\n", context->nb_solutions_total, context->nb_solutions_total == 1 ? "" : "s");
+
+  DLX_PRINT (context, "%lu solution%s found.\n\n", nb_solutions, nb_solutions == 1 ? "" : "s");
+
+  // The completed search is recorded, so that resuming from the checkpoint does not search again.
+  if (context->checkpoint_file)
+    dlx_search_frontier_write (context, context->checkpoint_file, ULONG_MAX, 0);
+
+  return nb_solutions;
+}
+
+unsigned long
+dlx_exact_cover_optimize (SearchContext context) __attribute__ ((overloadable)) {
+  if (!context)
+    return 0;
+
+  const struct universe *universe = context->universe;
+  unsigned long max_length = universe->nb_subsets - universe->nb_required_subsets;
+
+  DLX_PRINT (context, "Searching for the exact cover solution of minimal cost.\n");
+
+  // The weight of every subset is shared equally by its elements, for the lower bounds of costs.
+  context->share = malloc (universe->nb_nodes * sizeof (*context->share));
+  for (unsigned long s = 0; s < universe->nb_subsets; s++) {
+    unsigned long first = universe->subsets[s].node;
+    unsigned long length = 0;
+    unsigned long j = first;
+
+    do {
+      length++;
+      j = universe->matrix.links[j].nextElement;
+    } while (j != first);
+    do {
+      context->share[j] = universe->subsets[s].weight / length;
+      j = universe->matrix.links[j].nextElement;
+    } while (j != first);
+  }
+
+  // Subsets required in solutions are part of the cost.
+  context->path_cost = malloc ((max_length + 1) * sizeof (*context->path_cost));
+  context->path_cost[0] = 0;
+  for (unsigned long i = 0; i < universe->nb_required_subsets; i++)
+    context->path_cost[0] += universe->subsets[universe->required_subsets[i]].weight;
+
+  context->best = malloc ((max_length + 1) * sizeof (*context->best));
+  context->best_length = 0;
+  context->best_cost = HUGE_VAL;
+
+  // Symmetric images of a solution might not have the same cost, and checkpoints do not hold the best solution found so far:
+  // symmetries and checkpoints are not used.
+  const struct symmetry_group *symmetry = context->symmetry;
+  char *checkpoint_file = context->checkpoint_file;
+
+  context->symmetry = 0;
+  context->checkpoint_file = 0;
+  context->resume_length = context->resume_complete = context->prefix_length = 0;
+  context->nb_solutions_total = context->nb_solutions = context->nb_nodes = context->matrix.updates = 0;
+  context->nb_forced = context->nb_dead_ends = context->nb_path_forced = 0;
+  context->interrupted = 0;
+
+  context->next_checkpoint = ULONG_MAX;
+  context->next_progress = context->nb_nodes + context->progress_interval;
+  context->next_progress_time = context->progress_milliseconds ? dlx_clock_milliseconds () + context->progress_milliseconds : 0;
+  dlx_search_schedule (context);
+
+  dlx_search_root (context, 0);
+  context->stop_requested = 0;
+
+  context->symmetry = symmetry;
+  context->checkpoint_file = checkpoint_file;
+
+  // The best solution is displayed, even if the search was stopped before completion.
+  if (context->best_cost < HUGE_VAL) {
+    context->nb_solutions = context->nb_solutions_total = 1;
+    memcpy (context->solutions, context->best, context->best_length * sizeof (*context->solutions));
+    dlx_search_display_solution (context, context->best_length);
+    DLX_PRINT (context, "Solution of minimal cost %g found%s.\n\n", context->best_cost, context->interrupted ? " so far" : "");
+  } else {
+    if (!context->result) // In case no solutions were found.
+      DLX_DISPLAY_SOLUTION (context, 0, 0);
+    DLX_PRINT (context, "No solution found.\n\n");
+  }
+
+  free (context->share);
+  free (context->path_cost);
+  free (context->best);
+  context->share = context->path_cost = 0;
+  context->best = 0;
+
+  return context->nb_solutions;
+}
+
+unsigned long
+dlx_exact_cover_optimize (Universe universe) __attribute__ ((overloadable)) {
+  if (!universe)
+    return 0;
+
+  SearchContext context = dlx_search_context_create (universe);
+  /// @overload
+  unsigned long nb_solutions = dlx_exact_cover_optimize (context);
+
+  universe->cost = context->best_cost;
+  universe->nb_solutions_total = context->nb_solutions_total;
+  dlx_search_context_destroy (context);
+
+  return nb_solutions;
+}
+
+double
+dlx_solution_cost (Universe universe) __attribute__ ((overloadable)) {
+  return universe ? universe->cost : HUGE_VAL;
+}
+
+double
+dlx_solution_cost (SearchContext context) __attribute__ ((overloadable)) {
+  return context ? context->best_cost : HUGE_VAL;
+}
+
+unsigned long
+dlx_solution_length_max_set (Universe universe, unsigned long max_length) __attribute__ ((overloadable)) {
+  unsigned long old = universe->max_length;
+
+  universe->max_length = max_length;
+  return old;
+}
+
+unsigned long
+dlx_solution_length_max_set (SearchContext context, unsigned long max_length) __attribute__ ((overloadable)) {
+  unsigned long old = context->max_length;
+
+  context->max_length = max_length;
+  return old;
+}
+
+unsigned long
+dlx_exact_cover_search_shortest (SearchContext context, int one_only) __attribute__ ((overloadable)) {
+  if (!context)
+    return 0;
+
+  const struct universe *universe = context->universe;
+  const struct links *links = context->matrix.links;
+  unsigned long max_subset_length = universe->max_subset_length ? universe->max_subset_length : 1;
+  unsigned long max_length = context->max_length;
+  unsigned long left = 0;
+
+  for (unsigned long c = links[HEAD].nextElement; c != HEAD; c = links[c].nextElement)
+    left++;
+
+  // Checkpoints of the successive searches could not be resumed.
+  char *checkpoint_file = context->checkpoint_file;
+  unsigned long nb_nodes = 0, nb_solutions = 0;
+
+  context->checkpoint_file = 0;
+  context->deepening = 1;
+  context->interrupted = 0;
+
+  // Iterative deepening: the length of solutions is increased from its lower bound up to one subset per element left,
+  // so that the first search which finds solutions finds the shortest ones.
+  for (unsigned long length = universe->nb_required_subsets + (left + max_subset_length - 1) / max_subset_length;
+       !nb_solutions && !context->interrupted && length <= universe->nb_required_subsets + left && (!max_length || length <= max_length); length++) {
+    DLX_PRINT (context, "Solutions of %lu subset%s at most:\n", length, length == 1 ? "" : "s");
+    context->max_length = length;
+    /// @overload
+    nb_solutions = dlx_exact_cover_search (context, one_only);
+    nb_nodes += context->nb_nodes;
+  }
+
+  context->nb_nodes = nb_nodes;
+  context->max_length = max_length;
+  context->deepening = 0;
+  context->checkpoint_file = checkpoint_file;
+
+  if (!nb_solutions && !context->interrupted) // In case no solutions were found.
+    DLX_DISPLAY_SOLUTION (context, 0, 0);
+
+  return nb_solutions;
+}
+
+unsigned long
+dlx_exact_cover_search_shortest (Universe universe, int one_only) __attribute__ ((overloadable)) {
+  if (!universe)
+    return 0;
+
+  if (universe->symmetry && !universe->symmetry->group)
+    universe->symmetry->group = dlx_universe_symmetry_group (universe, universe->trace);
+
+  SearchContext context = dlx_search_context_create (universe);
+  /// @overload
+  unsigned long nb_solutions = dlx_exact_cover_search_shortest (context, one_only);
+
+  universe->nb_solutions_total = context->nb_solutions_total;
+  dlx_search_context_destroy (context);
+
+  return nb_solutions;
+}
+
+/// Writes bytes to the file of a solution sink (default writer.)
+/// @param [in] bytes Bytes to write.
+/// @param [in] size Number of bytes to write.
+/// @param [in] data Solution sink
+/// @return 1 if successful, 0 otherwise.
+static int
+dlx_sink_file_writer (const void *bytes, unsigned long size, void *data) {
+  SolutionSink sink = data;
+
+  return fwrite (bytes, 1, size, sink->file) == size;
+}
+
+SolutionSink
+dlx_sink_create (dlx_sink_writer writer, void *data, unsigned long capacity) __attribute__ ((overloadable)) {
+  if (!writer)
+    return 0;
+
+  SolutionSink sink = calloc (1, sizeof (*sink));
+
+  sink->writer = writer;
+  sink->data = data;
+  sink->capacity = capacity ? capacity : DLX_SINK_DEFAULT_CAPACITY;
+  sink->buffer = malloc (sink->capacity);
+
+  return sink;
+}
+
+SolutionSink
+dlx_sink_create (const char *filename, unsigned long capacity) __attribute__ ((overloadable)) {
+  FILE *file = filename ? fopen (filename, "wb") : 0;
+
+  if (!file)
+    return 0;
+
+  /// @overload
+  SolutionSink sink = dlx_sink_create (dlx_sink_file_writer, 0, capacity);
+
+  sink->data = sink;
+  sink->file = file;
+
+  return sink;
+}
+
+int
+dlx_sink_flush (SolutionSink sink) {
+  if (!sink)
+    return 0;
+
+  dlx_sink_write_buffer (sink);
+  if (sink->file && fflush (sink->file))
+    sink->failed = 1;
+
+  return !sink->failed;
+}
+
+unsigned long
+dlx_sink_solutions (SolutionSink sink) {
+  return sink ? sink->nb_solutions : 0;
+}
+
+void
+dlx_sink_destroy (SolutionSink sink) {
+  if (!sink)
+    return;
+
+  dlx_sink_flush (sink);
+  if (sink->file)
+    fclose (sink->file);
+  free (sink->previous);
+  free (sink->buffer);
+  free (sink);
+}
+
+SolutionSink
+dlx_sink_set (Universe universe, SolutionSink sink) __attribute__ ((overloadable)) {
+  SolutionSink old = universe->sink;
+
+  universe->sink = sink;
+  return old;
+}
+
+SolutionSink
+dlx_sink_set (SearchContext context, SolutionSink sink) __attribute__ ((overloadable)) {
+  SolutionSink old = context->sink;
+
+  context->sink = sink;
+  return old;
+}
+
+unsigned long
+dlx_sink_decode (Universe universe, const char *filename) {
+  FILE *file = universe && filename ? fopen (filename, "rb") : 0;
+
+  if (!file)
+    return 0;
+
+  const char **solution = 0;
+  unsigned long length = 0, capacity = 0, nb_solutions = 0, prefix, suffix;
+
+  while (dlx_varint_read (file, &prefix)) {
+    int ok = prefix <= length && dlx_varint_read (file, &suffix) && suffix <= universe->nb_subsets - prefix;
+
+    if (ok && prefix + suffix > capacity) {
+      capacity = 2 * (prefix + suffix);
+      solution = realloc (solution, capacity * sizeof (*solution));
+    }
+
+    for (unsigned long k = prefix, subset; ok && k < prefix + suffix; k++)
+      if ((ok = dlx_varint_read (file, &subset) && subset < universe->nb_subsets))
+        solution[k] = universe->subsets[subset].name;
+
+    if (!ok) {
+      DLX_PRINT (universe, "Solution sink: %s is malformed after %lu solutions.\n", filename, nb_solutions);
+      break;
+    }
+
+    length = prefix + suffix;
+    nb_solutions++;
+    if (universe->solution_displayer)
+      universe->solution_displayer (universe, length, solution, universe->solution_displayer_data);
+  }
+
+  free (solution);
+  fclose (file);
+
+  return nb_solutions;
+}
+
+int
+dlx_checkpoint_set (SearchContext context, const char *filename, unsigned long interval) {
+  if (!context)
+    return 0;
+
+  free (context->checkpoint_file);
+  context->checkpoint_file = filename && *filename ? strcpy (malloc (strlen (filename) + 1), filename) : 0;
+  context->checkpoint_interval = context->checkpoint_file ? interval : 0;
+  context->next_checkpoint = context->nb_nodes + context->checkpoint_interval;
+  dlx_search_schedule (context);
+
+  return 1;
+}
+
+void
+dlx_checkpoint_request (SearchContext context, int stop) {
+  // Only objects of type volatile sig_atomic_t are written, so that this function can be called from a signal handler.
+  if (stop)
+    context->stop_requested = 1;
+  context->checkpoint_requested = 1;
+}
+
+int
+dlx_checkpoint_resume (SearchContext context, const char *filename) {
+  if (!context || !filename)
+    return 0;
+
+  FILE *file = fopen (filename, "r");
+
+  if (!file) {
+    DLX_PRINT (context, "Checkpoint: %s can not be read.\n", filename);
+    return 0;
+  }
+
+  int version = 0, complete = 0;
+  unsigned long long fingerprint = 0;
+  unsigned long nb_nodes = 0, nb_solutions = 0, nb_solutions_total = 0, prefix = 0, depth = 0;
+  int ok = fscanf (file, "DLX checkpoint %i fingerprint %llx complete %i nodes %lu solutions %lu total %lu prefix %lu depth %lu path", &version,
+                   &fingerprint, &complete, &nb_nodes, &nb_solutions, &nb_solutions_total, &prefix, &depth) == 8 &&
+           version == DLX_CHECKPOINT_VERSION && fingerprint == dlx_search_fingerprint (context) && prefix <= depth &&
+           depth <= context->universe->nb_subsets - context->universe->nb_required_subsets;
+  unsigned long *path = ok ? malloc ((depth + 1) * sizeof (*path)) : 0;
+
+  for (unsigned long i = 0; ok && i < depth; i++)
+    ok = fscanf (file, "%lu", &path[i]) == 1 && path[i] < context->universe->nb_subsets;
+  fclose (file);
+
+  if (!ok) {
+    DLX_PRINT (context, "Checkpoint: %s does not match the universe.\n", filename);
+    free (path);
+    return 0;
+  }
+
+  free (context->resume_path);
+  context->resume_path = path;
+  context->resume_length = depth;
+  context->resume_complete = complete;
+  context->prefix_length = prefix;
+  context->nb_nodes = nb_nodes;
+  context->nb_solutions = nb_solutions;
+  context->nb_solutions_total = nb_solutions_total;
+
+  DLX_PRINT (context, "Checkpoint: resuming from %s at depth %lu, after %lu node%s and %lu solution%s.\n", filename, depth, nb_nodes,
+             nb_nodes == 1 ? "" : "s", nb_solutions, nb_solutions == 1 ? "" : "s");
+
+  return 1;
+}
+
+enum dlx_engine
+dlx_engine_set (Universe universe, enum dlx_engine engine) __attribute__ ((overloadable)) {
+  enum dlx_engine old = universe->engine;
+
+  universe->engine = engine;
+  return old;
+}
+
+enum dlx_engine
+dlx_engine_set (SearchContext context, enum dlx_engine engine) __attribute__ ((overloadable)) {
+  enum dlx_engine old = context->engine;
+
+  context->engine = engine;
+  return old;
+}
+
+enum dlx_subset_order
+dlx_subset_order_set (Universe universe, enum dlx_subset_order order) __attribute__ ((overloadable)) {
+  enum dlx_subset_order old = universe->subset_order;
+
+  universe->subset_order = order;
+  return old;
+}
+
+enum dlx_subset_order
+dlx_subset_order_set (SearchContext context, enum dlx_subset_order order) __attribute__ ((overloadable)) {
+  enum dlx_subset_order old = context->subset_order;
+
+  context->subset_order = order;
+  return old;
+}
+
+int
+dlx_subset_priority_set (Universe universe, const char *subset_name, double priority) {
+  if (!universe || !subset_name)
+    return 0;
+
+  int found = 0;
+  unsigned long hash = dlx_name_hash (subset_name);
+
+  for (unsigned long slot = dlx_universe_name_first (universe, subset_name, hash); slot != ULONG_MAX;
+       slot = dlx_universe_name_next (universe, subset_name, hash, slot + 1)) {
+    unsigned long s = dlx_name_subset (universe->name_table[slot].name);
+
+    // A subset merged into an identical subset is explored with it: it has no priority of its own.
+    if (dlx_universe_name_merged (universe, slot))
+      DLX_PRINT (universe, "Priority of subset %s not set (merged into subset %s ==> ignored).\n", subset_name,
+                 *universe->subsets[s].name ? universe->subsets[s].name : "(unnamed)");
+    else {
+      universe->subsets[s].priority = priority;
+      found = 1;
+    }
+  }
+
+  return found;
+}
+
+unsigned long
+dlx_auto_calibration_set (Universe universe, unsigned long nodes) __attribute__ ((overloadable)) {
+  unsigned long old = universe->calibration_nodes;
+
+  universe->calibration_nodes = nodes;
+  return old;
+}
+
+unsigned long
+dlx_auto_calibration_set (SearchContext context, unsigned long nodes) __attribute__ ((overloadable)) {
+  unsigned long old = context->calibration_nodes;
+
+  context->calibration_nodes = nodes;
+  return old;
+}
+
+const struct dlx_auto_choice *
+dlx_auto_choice (Universe universe) __attribute__ ((overloadable)) {
+  return universe && universe->choice.nb_workers ? &universe->choice : 0;
+}
 
-  /// @overload
-  Universe ret = dlx_universe_create (nb_cols, cols);
+const struct dlx_auto_choice *
+dlx_auto_choice (SearchContext context) __attribute__ ((overloadable)) {
+  return context && context->choice.nb_workers ? &context->choice : 0;
+}
 
-  free (sccpy);
+dlx_search_event_handler
+dlx_events_set (SearchContext context, dlx_search_event_handler handler, void *data) {
+  dlx_search_event_handler old = context->event_handler;
 
-  return ret;
+  context->event_handler = handler;
+  context->event_data = data;
+  return old;
+}
+
+dlx_progress_reporter
+dlx_progress_set (SearchContext context, dlx_progress_reporter reporter, void *data, unsigned long nodes, unsigned long milliseconds) {
+  dlx_progress_reporter old = context->progress_reporter;
+
+  context->progress_reporter = reporter;
+  context->progress_data = data;
+  context->progress_interval = reporter ? nodes : 0;
+  context->progress_milliseconds = reporter ? milliseconds : 0;
+  context->progress_levels = reporter ? DLX_PROGRESS_LEVELS : 0;
+  context->next_progress = context->nb_nodes + context->progress_interval;
+  context->next_progress_time = context->progress_milliseconds ? dlx_clock_milliseconds () + context->progress_milliseconds : 0;
+  dlx_search_schedule (context);
+
+  return old;
+}
+
+unsigned long
+dlx_search_nodes (SearchContext context) {
+  return context ? context->nb_nodes : 0;
 }
 
 int
-dlx_subset_define (Universe universe, const char *subset_name, unsigned long nb_elements, const char *elements[])
-    __attribute__ ((overloadable)) {
-  if (!universe || !subset_name || !nb_elements || !elements)
+dlx_memory_policy_set (Universe universe, int policy) {
+  int old = universe->memory_policy;
+
+  universe->memory_policy = policy;
+  return old;
+}
+
+const struct dlx_memory_statistics *
+dlx_memory_statistics (SearchContext context) {
+  if (!context)
     return 0;
+  if (!context->memory_stale)
+    return &context->memory;
+
+  // Huge pages backing the links are read from the mappings of the process, as reported by the system,
+  // once after the creation of the search context and after each search.
+  context->memory_stale = 0;
+  FILE *smaps = fopen ("/proc/self/smaps", "r");
+  unsigned long address = (unsigned long)context->matrix.links;
+
+  context->memory.huge_page_bytes = 0;
+  if (smaps) {
+    char line[512];
+    int inside = 0;
+
+    while (fgets (line, sizeof (line), smaps)) {
+      unsigned long start, end, kilobytes;
+
+      if (sscanf (line, "%lx-%lx ", &start, &end) == 2)
+        inside = start <= address && address < end;
+      else if (inside && (sscanf (line, "AnonHugePages: %lu kB", &kilobytes) == 1 || sscanf (line, "Private_Hugetlb: %lu kB", &kilobytes) == 1))
+        context->memory.huge_page_bytes += kilobytes * 1024;
+    }
+    fclose (smaps);
+  }
+  if (context->memory.huge_page_bytes > context->memory.bytes)
+    context->memory.huge_page_bytes = context->memory.bytes;
 
-  DLX_PRINT ("Elements in subset %s:", *subset_name ? subset_name : "(unnamed)");
-  int redo = 0;
+  return &context->memory;
+}
+
+unsigned long
+dlx_search_updates (SearchContext context) {
+  return context ? context->matrix.updates : 0;
+}
+
+unsigned long
+dlx_nogoods_set (SearchContext context, unsigned long capacity) {
+  if (!context)
+    return 0;
 
-  struct element *first_element = 0;
+  unsigned long old = context->nogood_statistics.capacity;
 
-  for (unsigned long i = 0; i < nb_elements; i++) {
-    if (!elements[i] || !*elements[i])
-      continue;
+  if (context->nogoods) {
+    free (context->nogoods->slots);
+    free (context->nogoods->subset_keys);
+    free (context->nogoods);
+    context->nogoods = 0;
+  }
+  memset (&context->nogood_statistics, 0, sizeof (context->nogood_statistics));
 
-    DLX_PRINT (" %s", elements[i]);
-    struct element *elementInUniverse = 0;
+  if (capacity) {
+    struct nogood_store *store = calloc (1, sizeof (*store));
 
-    if (!universe->unbound) {
-      if (!(elementInUniverse = dlx_head_get_element_by_name (universe->head, elements[i]))) {
-        DLX_PRINT (" (unknown element)");
-        redo = 1;
-        continue;
-      }
-    } else { // if (universe->unbound)
-      dlx_head_add_element (universe->head, elements[i]);
-      elementInUniverse = dlx_head_get_element_by_name (universe->head, elements[i]);
-    }
+    for (store->nb_buckets = 1; store->nb_buckets * DLX_NOGOOD_BUCKET < capacity; store->nb_buckets *= 2)
+      /**/;
+    store->slots = calloc (store->nb_buckets * DLX_NOGOOD_BUCKET, sizeof (*store->slots));
+    context->nogood_statistics.capacity = store->nb_buckets * DLX_NOGOOD_BUCKET;
+    context->nogoods = store;
+  }
 
-    struct element *elementInSubset = 0;
+  return old;
+}
 
-    if (first_element) {
-      int already_included = 0;
+const struct dlx_nogood_statistics *
+dlx_nogood_statistics (SearchContext context) {
+  return context ? &context->nogood_statistics : 0;
+}
 
-      elementInSubset = first_element;
+void
+dlx_sampling_set (SearchContext context, unsigned long nb_probes, unsigned long exact_nodes, unsigned long seed) {
+  if (!context)
+    return;
 
-      do {
-        if (!strcmp (elementInSubset->elementInUniverse->name, elements[i]))
-          already_included = 1; // element already included in subset
-        elementInSubset = elementInSubset->nextElement;
-      } while (elementInSubset != first_element && !already_included);
+  context->sampling_probes = nb_probes ? nb_probes : 1;
+  context->sampling_exact_nodes = exact_nodes;
+  context->sampling_exact_level = 0;
+  context->random_state = seed;
+}
 
-      if (already_included) {
-        DLX_PRINT (" (element already included in subset ==> ignored)");
-        redo = 1;
+unsigned long
+dlx_exact_cover_sample (SearchContext context, unsigned long nb_samples) {
+  if (!context)
+    return 0;
+
+  const struct universe *universe = context->universe;
+  unsigned long max_length = universe->nb_subsets - universe->nb_required_subsets;
+  struct dlx_sampling_quality *quality = &context->sampling_quality;
+
+  DLX_PRINT (context, "Drawing %lu exact cover solution%s at random.\n", nb_samples, nb_samples == 1 ? "" : "s");
+
+  context->nb_solutions_total = context->nb_solutions = context->nb_nodes = context->matrix.updates = 0;
+  context->interrupted = 0;
+  if (!context->sample)
+    context->sample = malloc ((max_length + 1) * sizeof (*context->sample));
+  memset (quality, 0, sizeof (*quality));
+  quality->effective_probes = HUGE_VAL;
+
+  double sum_weights = 0;
+  int exact = 0;
+
+  for (unsigned long s = 0; s < nb_samples; s++) {
+    // Solutions reached by the probes are kept at random with probabilities proportional to their weights (weighted reservoir.)
+    // Probes reaching no solution are not counted, unless no probe reaches any (the universe may have no solution.)
+    double weights = 0, squares = 0;
+    unsigned long sample_length = ULONG_MAX;
+    unsigned long hits = 0, misses = 0;
+
+    exact = 0;
+    while (hits < context->sampling_probes && !exact && (hits || misses < DLX_SAMPLING_MAX_MISSES * context->sampling_probes)) {
+      unsigned long length = ULONG_MAX;
+      double weight = dlx_sample_probe (context, 0, 1, &length, &exact);
+
+      quality->probes++;
+      if (weight <= 0) {
+        misses++;
         continue;
       }
+
+      hits++;
+      quality->successes++;
+      weights += weight;
+      squares += weight * weight;
+      if (dlx_sample_uniform (context) * weights < weight) {
+        memcpy (context->sample, context->solutions, length * sizeof (*context->sample));
+        sample_length = length;
+      }
     }
 
-    // Add element in subset
-    elementInSubset = malloc (sizeof (*elementInSubset));
+    sum_weights += weights;
+    if (exact && !weights) // No solution at all.
+      break;
+    if (sample_length == ULONG_MAX) // No solution reached.
+      break;
 
-    elementInSubset->name = strdup (subset_name);
-    elementInSubset->elementInUniverse = elementInUniverse;
-    elementInUniverse->size++; // Number of subsets containing the element is incremented
+    if (!exact && weights * weights / squares < quality->effective_probes)
+      quality->effective_probes = weights * weights / squares;
 
-    /// The element of the universe and subsets containing this element of the universe are doubly linked as circular lists (\p elementInPreviousSubsetContainingThisElementOfUnivers and \p elementInNextSubsetContainingThisElementOfUnivers).
-    elementInSubset->elementInNextSubsetContainingThisElementOfUniverse = elementInUniverse;
-    elementInSubset->elementInPreviousSubsetContainingThisElementOfUniverse = elementInUniverse->elementInPreviousSubsetContainingThisElementOfUniverse;
-    elementInUniverse->elementInPreviousSubsetContainingThisElementOfUniverse->elementInNextSubsetContainingThisElementOfUniverse = elementInSubset;
-    elementInUniverse->elementInPreviousSubsetContainingThisElementOfUniverse = elementInSubset;
+    memcpy (context->solutions, context->sample, sample_length * sizeof (*context->solutions));
+    context->nb_solutions_total++;
+    context->nb_solutions++;
+    dlx_search_display_solution (context, sample_length);
+  }
 
-    if (first_element == 0) {
-      elementInSubset->nextElement = elementInSubset->previousElement = elementInSubset;
-      first_element = elementInSubset;
+  quality->exact = exact;
+  quality->estimated_solutions = quality->probes ? sum_weights / quality->probes : 0;
+  if (!context->nb_solutions)
+    quality->effective_probes = 0;
+
+  DLX_PRINT (context, "%lu solution%s drawn (%lu probe%s, %lu successful, about %g solutions%s).\n\n", context->nb_solutions,
+             context->nb_solutions == 1 ? "" : "s", quality->probes, quality->probes == 1 ? "" : "s", quality->successes,
+             quality->estimated_solutions, exact ? ", exactly" : "");
+
+  return context->nb_solutions;
+}
+
+const struct dlx_sampling_quality *
+dlx_sampling_quality (SearchContext context) {
+  return context ? &context->sampling_quality : 0;
+}
+
+int
+dlx_search_interrupted (SearchContext context) {
+  return context ? context->interrupted : 0;
+}
+
+unsigned long
+dlx_jobs_split (SearchContext context, unsigned long depth, const char *prefix) {
+  if (!context || !prefix)
+    return 0;
+
+  DLX_PRINT (context, "Splitting the search into jobs at depth %lu.\n", depth);
+
+  context->resume_length = context->prefix_length = 0;
+  context->resume_complete = 0;
+  context->interrupted = 0;
+  context->nb_nodes = context->matrix.updates = 0;
+  context->nb_jobs = 0;
+  context->split_name = prefix;
+  context->split_depth = depth;
+  context->next_poll = ULONG_MAX; // No periodic tasks while splitting.
+  // The frontier is split with the settings of the search context, as the jobs are run (not with a previous automatic choice.)
+  context->choice.nb_workers = 0;
+  dlx_search_root (context, 0);
+  context->split_depth = ULONG_MAX;
+  context->split_name = 0;
+
+  DLX_PRINT (context, "%lu job%s written.\n", context->nb_jobs, context->nb_jobs == 1 ? "" : "s");
+
+  return context->nb_jobs;
+}
+
+int
+dlx_job_run (SearchContext context, const char *job, const char *result) {
+  if (!context || !job || !result || !dlx_checkpoint_resume (context, job))
+    return 0;
+
+  size_t length = strlen (result);
+  char temporary[length + sizeof (".tmp")];
+
+  strcpy (temporary, result);
+  strcpy (temporary + length, ".tmp");
+
+  if (!(context->result = fopen (temporary, "w"))) {
+    DLX_PRINT (context, "Job: %s can not be written.\n", temporary);
+    context->resume_length = context->prefix_length = 0;
+    context->resume_complete = 0;
+    return 0;
+  }
+
+  fprintf (context->result, "DLX result %i\n", DLX_CHECKPOINT_VERSION);
+  fprintf (context->result, "fingerprint %llx\n", dlx_search_fingerprint (context));
+  dlx_exact_cover_search (context, 0);
+  fprintf (context->result, "end nodes %lu solutions %lu total %lu\n", context->nb_nodes, context->nb_solutions, context->nb_solutions_total);
+
+  // The result is only published once the job is completed: an interrupted job is run again from its start.
+  int ok = !fclose (context->result) && !context->interrupted && !rename (temporary, result);
+
+  context->result = 0;
+  if (!ok) {
+    DLX_PRINT (context, "Job: %s not completed.\n", job);
+    remove (temporary);
+  }
+
+  return ok;
+}
+
+unsigned long
+dlx_jobs_merge (SearchContext context, const char *prefix, unsigned long nb_jobs) {
+  if (!context || !prefix)
+    return 0;
+
+  const struct universe *universe = context->universe;
+  unsigned long nb_required = universe->nb_required_subsets;
+  unsigned long long fingerprint = dlx_search_fingerprint (context);
+
+  context->nb_nodes = context->nb_solutions = context->nb_solutions_total = 0;
+  context->interrupted = 0;
+
+  for (unsigned long j = 0; j < nb_jobs; j++) {
+    char *filename = dlx_job_filename (prefix, j, ".result");
+    FILE *file = fopen (filename, "r");
+    int version = 0;
+    unsigned long long job_fingerprint = 0;
+    int ok = file && fscanf (file, "DLX result %i fingerprint %llx", &version, &job_fingerprint) == 2 && version == DLX_CHECKPOINT_VERSION &&
+             job_fingerprint == fingerprint;
+    char keyword[16] = "";
+
+    // Solutions are displayed (or written to the solution sink) as they are read. The counters of the job are read last.
+    while (ok && fscanf (file, "%15s", keyword) == 1 && !strcmp (keyword, "solution")) {
+      unsigned long length = 0, subset = 0;
+
+      ok = fscanf (file, "%lu", &length) == 1 && length <= universe->nb_subsets - nb_required;
+      for (unsigned long k = 0; ok && k < length; k++)
+        if ((ok = fscanf (file, "%lu", &subset) == 1 && subset < universe->nb_subsets)) {
+          context->solutions[k] = universe->subsets[subset].node;
+          context->solution[nb_required + k] = universe->subsets[subset].name;
+        }
+      if (ok && context->sink)
+        dlx_sink_write_solution (context->sink, universe, context->solutions, length);
+      else if (ok)
+        DLX_DISPLAY_SOLUTION (context, nb_required + length, context->solution);
+    }
+
+    unsigned long nb_nodes = 0, nb_solutions = 0, nb_solutions_total = 0;
+
+    ok = ok && !strcmp (keyword, "end") &&
+         fscanf (file, " nodes %lu solutions %lu total %lu", &nb_nodes, &nb_solutions, &nb_solutions_total) == 3;
+    if (ok) {
+      context->nb_nodes += nb_nodes;
+      context->nb_solutions += nb_solutions;
+      context->nb_solutions_total += nb_solutions_total;
     } else {
-      /// The elements of a subset are doubly linked as circular lists (\p previousElement and \p nextElement).
-      elementInSubset->nextElement = first_element;
-      elementInSubset->previousElement = first_element->previousElement;
-      first_element->previousElement->nextElement = elementInSubset;
-      first_element->previousElement = elementInSubset;
+      DLX_PRINT (context, "Job: %s is missing or does not match the universe.\n", filename);
+      context->interrupted = 1; // The merged search is incomplete.
     }
+
+    if (file)
+      fclose (file);
+    free (filename);
   }
 
-  if (first_element) // At least one element was added to the subset
-  {
-    universe->head->size++; // Number of subsets
+  if (!context->nb_solutions && !context->interrupted) // In case no solutions were found.
+    DLX_DISPLAY_SOLUTION (context, 0, 0);
+  DLX_PRINT (context, "%lu solution%s found by %lu job%s.\n\n", context->nb_solutions, context->nb_solutions == 1 ? "" : "s", nb_jobs,
+             nb_jobs == 1 ? "" : "s");
 
-    universe->solution_length++;
-    universe->solution = realloc (universe->solution, universe->solution_length * sizeof (*universe->solution));
-    universe->solution[universe->solution_length - 1] = 0;
+  return context->nb_solutions;
+}
 
-    if (redo) {
-      DLX_PRINT (" =");
-      struct element *elementInSubset = first_element;
+/// Runs some of the jobs of a split search.
+/// @param [in] context Search context
+/// @param [in] prefix Prefix of the names of the job files
+/// @param [in] first Index of the first job to run
+/// @param [in] step Index step between the jobs to run
+/// @param [in] nb_jobs Number of jobs
+static void
+dlx_jobs_run (SearchContext context, const char *prefix, unsigned long first, unsigned long step, unsigned long nb_jobs) {
+  for (unsigned long j = first; j < nb_jobs; j += step) {
+    char *job = dlx_job_filename (prefix, j, ".job");
+    char *result = dlx_job_filename (prefix, j, ".result");
+
+    dlx_job_run (context, job, result);
+    free (job);
+    free (result);
+  }
+}
 
-      do {
-        DLX_PRINT (" %s", elementInSubset->elementInUniverse->name);
-        elementInSubset = elementInSubset->nextElement;
-      } while (elementInSubset != first_element);
+unsigned long
+dlx_jobs_search (SearchContext context, unsigned long depth, const char *prefix, unsigned long nb_workers) {
+  if (!context || !prefix)
+    return 0;
+
+  unsigned long nb_jobs = dlx_jobs_split (context, depth, prefix);
+
+  if (!nb_workers)
+    nb_workers = 1;
+
+  // Worker processes share the search context by copy on write. Each one runs every nb_workers-th job.
+  fflush (0);
+  pid_t *workers = malloc (nb_workers * sizeof (*workers));
+
+  if (!workers) {
+    DLX_PRINT (context, "Jobs run without worker processes (out of memory).\n");
+    dlx_jobs_run (context, prefix, 0, 1, nb_jobs);
+    nb_workers = 0;
+  }
+
+  for (unsigned long w = 0; w < nb_workers; w++)
+    if ((workers[w] = fork ()) <= 0) {
+      dlx_jobs_run (context, prefix, w, nb_workers, nb_jobs);
+      // _exit does not flush streams: the output of the trace and of displayers is flushed (the result files are already closed.)
+      if (!workers[w]) {
+        fflush (stdout);
+        fflush (stderr);
+        _exit (0);
+      }
+      // If the worker process could not be created, its jobs are run by the coordinator.
     }
 
-    DLX_PRINT ("\n");
-    return 1;
-  } else {
-    DLX_PRINT (" (empty subset)\n");
+  for (unsigned long w = 0; w < nb_workers; w++)
+    if (workers[w] > 0)
+      waitpid (workers[w], 0, 0);
+  free (workers);
+
+  unsigned long nb_solutions = dlx_jobs_merge (context, prefix, nb_jobs);
+
+  // Job files are removed once merged. They are kept if some job failed, so that it can be run again.
+  for (unsigned long j = 0; !context->interrupted && j < nb_jobs; j++) {
+    char *job = dlx_job_filename (prefix, j, ".job");
+    char *result = dlx_job_filename (prefix, j, ".result");
+
+    remove (job);
+    remove (result);
+    free (job);
+    free (result);
+  }
+
+  return nb_solutions;
+}
+
+unsigned long
+dlx_exact_cover_search (Universe universe, int one_only) __attribute__ ((overloadable)) {
+  if (!universe)
+    return 0;
+
+  // The group of symmetries is computed once and shared by the search contexts.
+  if (universe->symmetry && !universe->symmetry->group)
+    universe->symmetry->group = dlx_universe_symmetry_group (universe, universe->trace);
+
+  SearchContext context = dlx_search_context_create (universe);
+  /// @overload
+  unsigned long nb_solutions = dlx_exact_cover_search (context, one_only);
+
+  universe->nb_solutions_total = context->nb_solutions_total;
+  universe->nb_forced = context->nb_forced;
+  universe->nb_dead_ends = context->nb_dead_ends;
+  universe->choice = context->choice;
+  dlx_search_context_destroy (context);
+
+  return nb_solutions;
+}
+
+Universe
+dlx_sudoku_create (unsigned long n, unsigned long nb_regions, const unsigned long regions[]) {
+  unsigned long size = n * n; // Number of rows, columns, boxes and digits.
+  unsigned long nb_cells = size * size;
+
+  if (!n || (nb_regions && !regions))
     return 0;
+
+  // Each extra region lists distinct cells of the grid.
+  for (unsigned long i = 0; i < nb_regions * size; i++) {
+    if (regions[i] >= nb_cells)
+      return 0;
+    for (unsigned long j = i - i % size; j < i; j++)
+      if (regions[j] == regions[i])
+        return 0;
   }
+
+  Universe universe = dlx_universe_create ();
+  universe->unbound = 0; // Bound universe.
+
+  // Elements: the cells, then the digits of the rows, of the columns, of the boxes and of the extra regions, each indexed by row, column, box or region, then digit.
+  char name[4 * 3 * sizeof (unsigned long) + 8];
+
+  for (unsigned long i = 0; i < nb_cells; i++) {
+    snprintf (name, sizeof (name), "R%luC%lu", i / size + 1, i % size + 1);
+    dlx_universe_append_element (universe, name);
+  }
+  const char *groups = "RCBX";
+  for (unsigned long g = 0; g < 4; g++)
+    for (unsigned long i = 0; i < (g < 3 ? size : nb_regions) * size; i++) {
+      snprintf (name, sizeof (name), "%c%lu#%lu", groups[g], i / size + 1, i % size + 1);
+      dlx_universe_append_element (universe, name);
+    }
+
+  unsigned long elements[4 + nb_regions];
+  unsigned long cell_regions[nb_regions + 1];
+
+  for (unsigned long row = 0; row < size; row++)
+    for (unsigned long column = 0; column < size; column++) {
+      unsigned long cell = row * size + column;
+      unsigned long box = (row / n) * n + column / n;
+      unsigned long nb_cell_regions = 0;
+
+      for (unsigned long r = 0; r < nb_regions; r++)
+        for (unsigned long i = 0; i < size; i++)
+          if (regions[r * size + i] == cell) {
+            cell_regions[nb_cell_regions++] = r;
+            break;
+          }
+
+      // Subsets are indexed by cell, then digit.
+      for (unsigned long digit = 0; digit < size; digit++) {
+        elements[0] = cell;
+        elements[1] = nb_cells + row * size + digit;
+        elements[2] = 2 * nb_cells + column * size + digit;
+        elements[3] = 3 * nb_cells + box * size + digit;
+        for (unsigned long r = 0; r < nb_cell_regions; r++)
+          elements[4 + r] = 4 * nb_cells + cell_regions[r] * size + digit;
+
+        snprintf (name, sizeof (name), "R%luC%lu#%lu", row + 1, column + 1, digit + 1);
+        dlx_subset_define (universe, name, 4 + nb_cell_regions, elements);
+      }
+    }
+
+  return universe;
 }
 
 int
-dlx_subset_define (Universe universe, const char *subset_name, const char *some_elements, const char *separators)
-    __attribute__ ((overloadable)) {
-  if (!some_elements)
+dlx_sudoku_decode (Universe universe, unsigned long n, unsigned long length, const char *const *solution, unsigned long grid[]) {
+  unsigned long size = n * n;
+
+  if (!universe || !grid || (length && !solution))
     return 0;
 
-  char *sccpy;
-  char *saveptr;
-  unsigned long nb_cols;
+  for (unsigned long i = 0; i < size * size; i++)
+    grid[i] = 0;
 
-  sccpy = strdup (some_elements);
-  nb_cols = 0;
-  for (char *c = sccpy; strtok_r (c, separators, &saveptr); c = 0)
-    nb_cols++;
-  free (sccpy);
+  for (unsigned long k = 0; k < length; k++) {
+    unsigned long subset = dlx_subset_index (universe, solution[k]);
 
-  if (!nb_cols)
+    if (subset >= size * size * size)
+      return 0;
+    grid[subset / size] = subset % size + 1;
+  }
+
+  return 1;
+}
+
+Universe
+dlx_queens_create (unsigned long n) {
+  if (!n)
     return 0;
 
-  const char *cols[nb_cols];
-  char *colname;
+  Universe universe = dlx_universe_create ();
+  universe->unbound = 0; // Bound universe.
 
-  sccpy = strdup (some_elements);
-  nb_cols = 0;
-  for (char *c = sccpy; (colname = strtok_r (c, separators, &saveptr)); c = 0)
-    cols[nb_cols++] = colname;
+  // Elements: the rows and the columns, then the diagonals (A) and the anti-diagonals (B), which are disabled.
+  char name[2 * 3 * sizeof (unsigned long) + 4];
+  const char *groups = "RCAB";
 
-  /// @overload
-  int ret = dlx_subset_define (universe, subset_name, nb_cols, cols);
+  for (unsigned long g = 0; g < 4; g++)
+    for (unsigned long i = 0; i < (g < 2 ? n : 2 * n - 1); i++) {
+      snprintf (name, sizeof (name), "%c%lu", groups[g], i + 1);
+      dlx_universe_append_element (universe, name);
+    }
 
-  free (sccpy);
+  for (unsigned long i = 2 * n; i < universe->nb_elements; i++)
+    dlx_universe_element_state_set (universe, i, 1);
 
-  return ret;
+  // Subsets are indexed by row, then column.
+  for (unsigned long row = 0; row < n; row++)
+    for (unsigned long column = 0; column < n; column++) {
+      unsigned long elements[] = { row, n + column, 2 * n + row + column, 4 * n - 1 + row + n - 1 - column };
+
+      snprintf (name, sizeof (name), "R%luC%lu", row + 1, column + 1);
+      dlx_subset_define (universe, name, sizeof (elements) / sizeof (*elements), elements);
+    }
+
+  return universe;
 }
 
 int
-dlx_subset_require_in_solution (Universe universe, const char *subset_name) {
-  if (!universe || !subset_name)
+dlx_queens_decode (Universe universe, unsigned long n, unsigned long length, const char *const *solution, unsigned long columns[]) {
+  if (!universe || !columns || (length && !solution))
     return 0;
 
-  DLX_PRINT ("Subset required in solution:\n");
-  DLX_PRINT ("  [%lu]\tSubset %s:", universe->solution_length - universe->head->size + 1, subset_name);
-
-  // In case of several candidate subsets (with the same name), a subset is chosen arbitrarily
-  // (the subset with an element in the first element, in order of addded element to the universe,
-  // then the first subset, in order of added subsets to the universe)
-  for (struct element *elementInUniverse = universe->head->nextElement; elementInUniverse != universe->head;
-       elementInUniverse = elementInUniverse->nextElement)
-    // Look for the first element of the subset 'subset_name' (in order of creation in universe).
-    for (struct element *elementInSubset = elementInUniverse->elementInNextSubsetContainingThisElementOfUniverse;
-         elementInSubset != elementInUniverse;
-         elementInSubset = elementInSubset->elementInNextSubsetContainingThisElementOfUniverse)
-      if (!strcmp (elementInSubset->name, subset_name)) {
-        // The selected subset conforms to theses conditions:
-        // - subset name is 'subset_name'
-        // - subset was not previously required in the solution
-        struct element *j = elementInSubset;
-
-        // Removes the elements contained in the required subset
-        // and all the subsets which contain these elements, the required subset included.
-        do {
-          DLX_PRINT (" %s", j->elementInUniverse->name); // Name of the element.
+  for (unsigned long row = 0; row < n; row++)
+    columns[row] = ULONG_MAX;
 
-          // This subset containing element might also contain elements which are
-          // de facto included in the solution.
-          // We can therefore remove these elements from the universe.
+  for (unsigned long k = 0; k < length; k++) {
+    unsigned long subset = dlx_subset_index (universe, solution[k]);
+
+    if (subset >= n * n)
+      return 0;
+    columns[subset / n] = subset % n;
+  }
 
-          // Furthermore, the solution can not contain subsets that
-          // contain this element, otherwise,
-          // there would be more than one subset containing this element in the solution.
-          // Thus, those elements can be removed from the universe.
+  return 1;
+}
 
-          dlx_element_cover (j->elementInUniverse);
+/// Cell of the board of a polyomino puzzle, with its index in the board.
+struct dlx_board_cell {
+  struct dlx_cell cell; ///< Coordinates of the cell (first, so that cells of the board compare as cells.)
+  unsigned long index;  ///< Index of the cell in the board.
+};
 
-          // Keep a reference to the uncovered element for further access in dlx_universe_destroy.
-          universe->uncover_column_length++;
-          universe->uncover_column = realloc (universe->uncover_column, universe->uncover_column_length * sizeof (*universe->uncover_column));
-          universe->uncover_column[universe->uncover_column_length - 1] = j->elementInUniverse;
+/// Compares two cells by coordinates (for qsort and bsearch).
+static int
+dlx_cell_compare (const void *a, const void *b) {
+  const struct dlx_cell *ca = a;
+  const struct dlx_cell *cb = b;
+
+  if (ca->x != cb->x)
+    return ca->x < cb->x ? -1 : 1;
+  if (ca->y != cb->y)
+    return ca->y < cb->y ? -1 : 1;
+  return ca->z < cb->z ? -1 : ca->z > cb->z ? 1 : 0;
+}
 
-          j = j->nextElement;
-        } while (j != elementInSubset);
+/// Generates the distinct orientations of a piece.
+/// @param [in] piece Piece
+/// @param [in] dimensions 2 for rotations in the plane (x, y), 3 for rotations in space.
+/// @param [in] reflections 1 if reflections are allowed, 0 otherwise.
+/// @param [out] orientations Cells of the orientations, orientation after orientation (at most 48 orientations of the cells of the piece.)
+/// @return Number of distinct orientations, or 0 if some cell of the piece is repeated.
+///
+/// Orientations are the signed permutations of the axes (of determinant 1 unless reflections are allowed.)
+/// The cells of each orientation are sorted, and translated so that the first one is at the origin: identical orientations are then identical lists.
+static unsigned long
+dlx_piece_orientations (const struct dlx_piece *piece, unsigned int dimensions, int reflections, struct dlx_cell *orientations) {
+  static const unsigned int permutations[6][3] = { { 0, 1, 2 }, { 1, 0, 2 }, { 0, 2, 1 }, { 2, 1, 0 }, { 1, 2, 0 }, { 2, 0, 1 } };
+  static const int parities[6] = { 1, -1, -1, -1, 1, 1 };
+  unsigned long length = piece->nb_cells;
+  unsigned long nb_orientations = 0;
 
-        DLX_PRINT ("\n");
+  for (unsigned int p = 0; p < (dimensions == 2 ? 2 : 6); p++)
+    for (unsigned int s = 0; s < 1U << dimensions; s++) {
+      int sign[3] = { s & 1 ? -1 : 1, s & 2 ? -1 : 1, s & 4 ? -1 : 1 };
 
-        universe->solution[universe->solution_length - universe->head->size] = strdup (subset_name);
-        universe->head->size--;
+      if (!reflections && parities[p] * sign[0] * sign[1] * sign[2] < 0)
+        continue;
 
-        // break loops and return.
-        return 1;
-      } // if (!strcmp (element->Name, subset_name))
+      struct dlx_cell *orientation = orientations + nb_orientations * length;
 
-  DLX_PRINT (" (unknown or incompatible subset ==> not required in solutions)\n");
+      for (unsigned long c = 0; c < length; c++) {
+        long v[3] = { piece->cells[c].x, piece->cells[c].y, piece->cells[c].z };
 
-  // The required subset can not be part of the solution : either it's unknown by name, or it is not
-  // compatible with other subsets already included in a required solution.
-  return 0;
+        orientation[c].x = sign[0] * v[permutations[p][0]];
+        orientation[c].y = sign[1] * v[permutations[p][1]];
+        orientation[c].z = sign[2] * v[permutations[p][2]];
+      }
+
+      qsort (orientation, length, sizeof (*orientation), dlx_cell_compare);
+      struct dlx_cell origin = orientation[0];
+
+      for (unsigned long c = 0; c < length; c++) {
+        orientation[c].x -= origin.x;
+        orientation[c].y -= origin.y;
+        orientation[c].z -= origin.z;
+        if (c && !dlx_cell_compare (&orientation[c - 1], &orientation[c]))
+          return 0;
+      }
+
+      int known = 0;
+
+      for (unsigned long o = 0; o < nb_orientations && !known; o++)
+        known = !memcmp (orientations + o * length, orientation, length * sizeof (*orientation));
+
+      if (!known)
+        nb_orientations++;
+    }
+
+  return nb_orientations;
 }
 
-unsigned long
-dlx_exact_cover_search (Universe universe, int one_only) {
-  if (!universe)
+Universe
+dlx_polyomino_create (unsigned long nb_cells, const struct dlx_cell board[], unsigned long nb_pieces, const struct dlx_piece pieces[],
+                      unsigned int dimensions, int reflections) {
+  if (!nb_cells || !board || !nb_pieces || !pieces || dimensions < 2 || dimensions > 3)
     return 0;
 
-  DLX_PRINT ("Searching for %s exact cover solution%s.\n", one_only ? "the first" : "all", one_only ? "" : "s");
+  for (unsigned long p = 0; p < nb_pieces; p++)
+    if (!pieces[p].name || !*pieces[p].name || !pieces[p].nb_cells || !pieces[p].cells)
+      return 0;
 
-  unsigned long nb_solutions = 0;
+  // Cells of the board are found by their coordinates in a sorted copy of the board.
+  struct dlx_board_cell *sorted = malloc (nb_cells * sizeof (*sorted));
 
-  if (universe->head->size) {
-    struct element **solutions = calloc (universe->head->size, sizeof (*solutions));
-    nb_solutions = dlx_universe_search (universe, solutions, 0, one_only);
-    free (solutions);
-  } else
-    nb_solutions = dlx_universe_search (universe, 0, 0, one_only);
+  if (!sorted)
+    return 0;
+  for (unsigned long i = 0; i < nb_cells; i++) {
+    sorted[i].cell = board[i];
+    sorted[i].index = i;
+  }
+  qsort (sorted, nb_cells, sizeof (*sorted), dlx_cell_compare);
+  for (unsigned long i = 1; i < nb_cells; i++)
+    if (!dlx_cell_compare (&sorted[i - 1], &sorted[i])) { // Repeated cell.
+      free (sorted);
+      return 0;
+    }
+
+  Universe universe = dlx_universe_create ();
+  universe->unbound = 0; // Bound universe.
+
+  // Elements: the pieces, then the cells of the board.
+  char name[3 * 3 * sizeof (long) + 4];
+
+  for (unsigned long p = 0; p < nb_pieces; p++)
+    dlx_universe_append_element (universe, pieces[p].name);
+  for (unsigned long i = 0; i < nb_cells; i++) {
+    if (dimensions == 2)
+      snprintf (name, sizeof (name), "%ld,%ld", board[i].x, board[i].y);
+    else
+      snprintf (name, sizeof (name), "%ld,%ld,%ld", board[i].x, board[i].y, board[i].z);
+    dlx_universe_append_element (universe, name);
+  }
 
-  if (!nb_solutions) // In case no solutions were found.
-    DLX_DISPLAY_SOLUTION (universe, 0, 0);
+  // Subsets: every placement of every orientation of every piece, the first cell of the orientation on every cell of the board.
+  for (unsigned long p = 0; p < nb_pieces; p++) {
+    unsigned long length = pieces[p].nb_cells;
+    struct dlx_cell *orientations = malloc (48 * length * sizeof (*orientations));
+    unsigned long nb_orientations = dlx_piece_orientations (&pieces[p], dimensions, reflections, orientations);
+    unsigned long elements[1 + length];
+    char subset_name[strlen (pieces[p].name) + sizeof (name) + 3 * sizeof (unsigned long) + 4];
+
+    if (!nb_orientations) { // Repeated cell.
+      free (orientations);
+      free (sorted);
+      dlx_universe_destroy (universe);
+      return 0;
+    }
 
-  DLX_PRINT ("%lu solution%s found.\n\n", nb_solutions, nb_solutions == 1 ? "" : "s");
+    elements[0] = p;
+    for (unsigned long o = 0; o < nb_orientations; o++)
+      for (unsigned long anchor = 0; anchor < nb_cells; anchor++) {
+        unsigned long c;
 
-  return nb_solutions;
+        for (c = 0; c < length; c++) {
+          struct dlx_cell cell = { board[anchor].x + orientations[o * length + c].x, board[anchor].y + orientations[o * length + c].y,
+                                   board[anchor].z + orientations[o * length + c].z };
+          const struct dlx_board_cell *found = bsearch (&cell, sorted, nb_cells, sizeof (*sorted), dlx_cell_compare);
+
+          if (!found)
+            break;
+          elements[1 + c] = nb_pieces + found->index;
+        }
+
+        if (c < length) // The placement does not fit in the board.
+          continue;
+
+        snprintf (subset_name, sizeof (subset_name), "%s#%lu@%s", pieces[p].name, o + 1, universe->elements[nb_pieces + anchor].name);
+        dlx_subset_define (universe, subset_name, 1 + length, elements);
+      }
+
+    free (orientations);
+  }
+
+  free (sorted);
+  return universe;
 }
 
-void
-dlx_universe_destroy (Universe universe) {
-  if (!universe)
-    return;
+int
+dlx_polyomino_decode (Universe universe, unsigned long nb_pieces, unsigned long length, const char *const *solution, unsigned long board[]) {
+  if (!universe || !board || (length && !solution) || nb_pieces > universe->nb_elements)
+    return 0;
 
-  for (unsigned long i = universe->uncover_column_length; i > 0; i--)
-    dlx_element_uncover (universe->uncover_column[i - 1]);
-  free (universe->uncover_column);
+  for (unsigned long i = nb_pieces; i < universe->nb_elements; i++)
+    board[i - nb_pieces] = ULONG_MAX;
 
-  struct element *nc = 0;
+  // The first element of a placement is its piece, followed by the cells it covers.
+  for (unsigned long k = 0; k < length; k++) {
+    unsigned long subset = dlx_subset_index (universe, solution[k]);
 
-  for (struct element *elementInUniverse = universe->head->nextElement; elementInUniverse != universe->head;
-       elementInUniverse = nc) {
-    struct element *ne = 0;
+    if (subset == ULONG_MAX)
+      return 0;
 
-    for (struct element *elementInSubset = elementInUniverse->elementInNextSubsetContainingThisElementOfUniverse;
-         elementInSubset != elementInUniverse; elementInSubset = ne) {
-      free (elementInSubset->name);
-      ne = elementInSubset->elementInNextSubsetContainingThisElementOfUniverse;
-      free (elementInSubset);
-    }
+    unsigned long first = universe->subsets[subset].node;
+    unsigned long piece = universe->columns[first];
 
-    free (elementInUniverse->name);
-    nc = elementInUniverse->nextElement;
-    free (elementInUniverse);
+    if (piece >= nb_pieces)
+      return 0;
+    for (unsigned long j = universe->matrix.links[first].nextElement; j != first; j = universe->matrix.links[j].nextElement)
+      board[universe->columns[j] - nb_pieces] = piece;
   }
-  free (universe->head);
 
-  for (unsigned long i = 0; i < universe->solution_length; i++)
-    free (universe->solution[i]);
-  free (universe->solution);
+  return 1;
+}
+
+void
+dlx_universe_destroy (Universe universe) {
+  if (!universe)
+    return;
+
+  free (universe->uncover_column);
+  free (universe->required_subsets);
+  free (universe->required_names);
+  free (universe->assumptions);
+
+  // Blocks of storage of names are released by the last universe referencing them.
+  for (unsigned long i = 0; i < universe->nb_name_pools; i++)
+    if (!__atomic_sub_fetch (&universe->name_pools[i]->references, 1, __ATOMIC_ACQ_REL))
+      free (universe->name_pools[i]);
+  free (universe->name_pools);
+  free (universe->columns);
+  free (universe->rows);
+  free (universe->matrix.links);
+  free (universe->matrix.size);
+
+  free (universe->elements);
+  free (universe->subsets);
+  free (universe->subset_table);
+  free (universe->name_table);
+
+  if (universe->symmetry) {
+    dlx_symmetry_group_free (universe->symmetry->group);
+    for (unsigned long i = 0; i < universe->symmetry->nb_generators; i++)
+      free (universe->symmetry->generators[i]);
+    free (universe->symmetry->generators);
+    free (universe->symmetry);
+  }
 
   free (universe);
 }
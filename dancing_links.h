@@ -28,6 +28,13 @@
 /// Objet Universe
 typedef struct universe *Universe;
 
+/// Objet SearchContext
+///
+/// A search context holds the state of a search on a universe.
+/// The universe itself is not modified by a search on a search context: it can be shared read-only by several search contexts,
+/// for instance one per thread.
+typedef struct search_context *SearchContext;
+
 /// Initialises a new unbound universe.
 /// @return universe
 /// @note The extension of the universe will match its subsets later added by dlx_subset_define(Universe universe, const char *subset_name, const char *list_of_some_elements, const char *separators)
@@ -51,6 +58,17 @@ Universe dlx_universe_create (const char *list_of_elements, const char *separato
 /// @post User must call dlx_universe_destroy(Universe universe) later.
 Universe dlx_universe_create (unsigned long nb_elements, const char *elements[]) __attribute__ ((overloadable));
 
+/// Duplicates a universe.
+/// @param [in] universe Universe
+/// @return Copy of the universe, with the same elements, subsets, required subsets, symmetries, solution displayer and trace setting.
+/// @post User must call dlx_universe_destroy(Universe universe) later.
+///
+/// The copy is cheap: the elements are copied as a whole, and names are shared by reference with the original universe.
+/// The copy can then be modified (subsets defined or required in solutions) independently of the original universe.
+/// For instance, a base universe can be cloned for each problem to solve, and the clone completed by subsets required in solutions.
+/// Universes can be cloned concurrently, provided they are not modified meanwhile.
+Universe dlx_universe_clone (const struct universe *universe);
+
 /// Adds a subset to the universe.
 /// @param [in] universe Universe
 /// @param [in] subset_name Name of the added subset
@@ -71,6 +89,63 @@ int dlx_subset_define (Universe universe, const char *subset_name, const char *l
 int dlx_subset_define (Universe universe, const char *subset_name, unsigned long nb_elements, const char *some_elements[])
     __attribute__ ((overloadable));
 
+/// Adds a subset to the universe.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the added subset
+/// @param [in] nb_elements Number of elements of the universe contained in the subset.
+/// @param [in] some_elements Indices of elements of the universe contained in the subset
+///             (elements of the universe are indexed from 0 in order of declaration.)
+/// @return 1 if added successfully, 0 otherwise.
+///
+/// Elements are not looked for by name: large models generated by a program are built faster.
+/// The universe is not extended by the subset, even if it is unbound.
+int dlx_subset_define (Universe universe, const char *subset_name, unsigned long nb_elements, const unsigned long some_elements[])
+    __attribute__ ((overloadable));
+
+/// Adds a weighted subset to the universe.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the added subset
+/// @param [in] weight Cost of the subset in a solution (not negative.)
+/// @param [in] list_of_some_elements List of elements of the universe contained in the subset, separated by separators.
+/// @param [in] separators List of accepted separators, terminated by \0.
+/// @return 1 if added successfully, 0 otherwise.
+///
+/// Subsets defined without weight weigh 1. Weights are used by dlx_exact_cover_optimize().
+int dlx_subset_define (Universe universe, const char *subset_name, double weight, const char *list_of_some_elements, const char *separators)
+    __attribute__ ((overloadable));
+
+/// Adds a weighted subset to the universe.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the added subset
+/// @param [in] weight Cost of the subset in a solution (not negative.)
+/// @param [in] nb_elements Number of elements of the universe contained in the subset.
+/// @param [in] some_elements Names of elements of the universe contained in the subset.
+/// @return 1 if added successfully, 0 otherwise.
+int dlx_subset_define (Universe universe, const char *subset_name, double weight, unsigned long nb_elements, const char *some_elements[])
+    __attribute__ ((overloadable));
+
+/// Merges identical subsets at definition.
+/// @param [in] universe Universe
+/// @param [in] merge 1 to merge identical subsets, 0 otherwise (default.)
+/// @return Previous setting.
+///
+/// Once set, a subset defined with the same elements and weight as an enabled subset already defined is not added:
+/// the multiplicity of the subset already defined is incremented instead (see dlx_subset_multiplicity()), and its name is kept.
+/// The name of a merged subset is kept as another name of the identical subset: requiring it by that name requires the identical subset
+/// (released by that name only), but solutions show the name of the identical subset. Disabling or enabling it by that name only decrements or increments
+/// the multiplicity of the identical subset, and its priority is the one of the identical subset.
+/// Subsets are found by a hash of their elements, in constant time.
+/// The search then branches once per distinct subset, and dlx_exact_cover_search() returns (and displays) distinct solutions only,
+/// while dlx_solutions_total() counts the solutions of the model before merge.
+/// Multiplicities are expected to be left unchanged by declared symmetries.
+int dlx_duplicates_merge_set (Universe universe, int merge);
+
+/// Gets the multiplicity of a subset.
+/// @param [in] universe Universe
+/// @param [in] subset Index of the subset (see dlx_subset_index().)
+/// @return Number of identical subsets merged into the subset by dlx_duplicates_merge_set(), itself included and merged subsets disabled by their names excluded (1 if none), or 0 if the subset does not exist.
+unsigned long dlx_subset_multiplicity (Universe universe, unsigned long subset);
+
 /// Requires that a subset be included in any solution.
 /// @param [in] universe Universe
 /// @param [in] subset_name Name of the required subset
@@ -78,6 +153,140 @@ int dlx_subset_define (Universe universe, const char *subset_name, unsigned long
 /// @post User can therefore optionally add constraints to the searched solutions.
 int dlx_subset_require_in_solution (Universe universe, const char *subset_name);
 
+/// Releases a subset previously required in solutions with dlx_subset_require_in_solution().
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the required subset
+/// @return 1 if successful, 0 otherwise (the subset was not the last subset required in solutions.)
+///
+/// Only the last subset required in solutions can be released, by the name it was required by
+/// (a subset merged into an identical subset, see dlx_duplicates_merge_set(), by its own name only),
+/// in O(number of elements of the subset): subsets required before it are released in reverse order, or with dlx_assumption_pop().
+int dlx_subset_unrequire_in_solution (Universe universe, const char *subset_name);
+
+/// Reasons why a subset could not be required in solutions.
+enum dlx_conflict_reason {
+  DLX_CONFLICT_NONE = 0,          ///< No conflict: the subset was required in solutions.
+  DLX_CONFLICT_UNKNOWN_SUBSET,    ///< No subset has this name.
+  DLX_CONFLICT_DISABLED_SUBSET,   ///< The subsets with this name are disabled.
+  DLX_CONFLICT_ELEMENT_COVERED,   ///< An element of the subset is already covered by a subset required in solutions.
+  DLX_CONFLICT_DISABLED_ELEMENTS, ///< The subset only contains disabled elements.
+};
+
+/// Report of the last call to dlx_subset_require_in_solution().
+///
+/// Names are owned by the universe.
+struct dlx_conflict {
+  enum dlx_conflict_reason reason; ///< Reason of the conflict, DLX_CONFLICT_NONE if the subset was required in solutions.
+  const char *subset;              ///< Name of the subset (0 if unknown.)
+  const char *element;             ///< Name of the element already covered (for DLX_CONFLICT_ELEMENT_COVERED only, 0 otherwise.)
+  const char *required;            ///< Name of the subset required in solutions covering this element (for DLX_CONFLICT_ELEMENT_COVERED only, 0 otherwise.)
+};
+
+/// Gets the report of the last call to dlx_subset_require_in_solution().
+/// @param [in] universe Universe
+/// @return Report of the conflict, valid until the next call to dlx_subset_require_in_solution().
+///
+/// If several subsets have the requested name, the conflict of the first enabled one (in order of definition) is reported.
+const struct dlx_conflict *dlx_assumption_conflict (Universe universe);
+
+/// Pushes a level on the stack of assumptions of the universe.
+/// @param [in] universe Universe
+/// @return Number of levels in the stack of assumptions.
+/// @post User should call dlx_assumption_pop(Universe universe) later.
+///
+/// Subsets required in solutions with dlx_subset_require_in_solution() after this call are assumptions,
+/// released all at once by dlx_assumption_pop(), so that a base model can be solved under many different assumptions.
+unsigned long dlx_assumption_push (Universe universe);
+
+/// Pops a level from the stack of assumptions of the universe.
+/// @param [in] universe Universe
+/// @return 1 if a level was popped, 0 if the stack is empty.
+///
+/// The subsets required in solutions since the matching call to dlx_assumption_push() are released in reverse order,
+/// in O(number of links restored); subsets required before are kept.
+int dlx_assumption_pop (Universe universe);
+
+/// Disables the subsets with a given name, until they are enabled again with dlx_subset_enable().
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the subsets
+/// @return 1 if at least one subset was disabled, 0 otherwise.
+///
+/// Disabled subsets are part of no solution. Subsets required in solutions can not be disabled.
+/// Subsets are found by name in constant time on average, and disabled in constant time, whatever the subsets required in solutions:
+/// they are removed from the links of search contexts created afterwards, in O(number of elements of disabled subsets).
+int dlx_subset_disable (Universe universe, const char *subset_name) __attribute__ ((overloadable));
+
+/// Disables a subset, until it is enabled again with dlx_subset_enable().
+/// @param [in] universe Universe
+/// @param [in] subset Index of the subset (see dlx_subset_index().)
+/// @return 1 if the subset was disabled, 0 otherwise.
+int dlx_subset_disable (Universe universe, unsigned long subset) __attribute__ ((overloadable));
+
+/// Enables the subsets with a given name, disabled by dlx_subset_disable().
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the subsets
+/// @return 1 if at least one subset was enabled, 0 otherwise.
+///
+/// Searches explore the subsets in the same order as if they had never been disabled.
+int dlx_subset_enable (Universe universe, const char *subset_name) __attribute__ ((overloadable));
+
+/// Enables a subset, disabled by dlx_subset_disable().
+/// @param [in] universe Universe
+/// @param [in] subset Index of the subset (see dlx_subset_index().)
+/// @return 1 if the subset was enabled, 0 otherwise.
+int dlx_subset_enable (Universe universe, unsigned long subset) __attribute__ ((overloadable));
+
+/// Disables an element of the universe, until it is enabled again with dlx_element_enable().
+/// @param [in] universe Universe
+/// @param [in] element_name Name of the element
+/// @return 1 if the element was disabled, 0 otherwise.
+///
+/// A disabled element is no longer required to be covered by solutions, but is still covered by at most one subset of a solution.
+/// Subsets containing it are kept, but subsets containing only disabled elements are part of no solution.
+/// The element is disabled in constant time, once found by name, whatever the subsets required in solutions.
+int dlx_element_disable (Universe universe, const char *element_name) __attribute__ ((overloadable));
+
+/// Disables an element of the universe, until it is enabled again with dlx_element_enable().
+/// @param [in] universe Universe
+/// @param [in] element Index of the element (elements of the universe are indexed from 0 in order of declaration.)
+/// @return 1 if the element was disabled, 0 otherwise.
+int dlx_element_disable (Universe universe, unsigned long element) __attribute__ ((overloadable));
+
+/// Enables an element of the universe, disabled by dlx_element_disable().
+/// @param [in] universe Universe
+/// @param [in] element_name Name of the element
+/// @return 1 if the element was enabled, 0 otherwise.
+int dlx_element_enable (Universe universe, const char *element_name) __attribute__ ((overloadable));
+
+/// Enables an element of the universe, disabled by dlx_element_disable().
+/// @param [in] universe Universe
+/// @param [in] element Index of the element (elements of the universe are indexed from 0 in order of declaration.)
+/// @return 1 if the element was enabled, 0 otherwise.
+int dlx_element_enable (Universe universe, unsigned long element) __attribute__ ((overloadable));
+
+/// Declares a symmetry of the universe, as a permutation of its elements.
+/// @param [in] universe Universe
+/// @param [in] nb_elements Number of elements of the universe.
+/// @param [in] images Indices of the images of the elements of the universe, identified by their indices
+///             (elements of the universe are indexed from 0 in order of declaration.)
+/// @return 1 if the symmetry is declared successfully, 0 otherwise.
+/// @pre The permutation must map every subset of the universe on a subset of the universe. Subsets should therefore be defined first.
+///
+/// Solutions which are images of each other by the group generated by the declared symmetries are equivalent.
+/// dlx_exact_cover_search() then only searches for one solution of each class of equivalence (the canonical one).
+/// The total number of solutions, symmetric images included, is given by dlx_solutions_total().
+/// If the declared symmetries generate a group of more than 4096 permutations, they are all ignored (and the search is run without symmetries.)
+int dlx_symmetry_define (Universe universe, unsigned long nb_elements, const unsigned long images[]) __attribute__ ((overloadable));
+
+/// Declares a symmetry of the universe, as a permutation of its elements.
+/// @param [in] universe Universe
+/// @param [in] nb_elements Number of elements in \p elements and \p images.
+/// @param [in] elements Names of elements of the universe.
+/// @param [in] images Names of the images of the elements in \p elements. Elements not listed in \p elements are left unchanged.
+/// @return 1 if the symmetry is declared successfully, 0 otherwise.
+int dlx_symmetry_define (Universe universe, unsigned long nb_elements, const char *elements[], const char *images[])
+    __attribute__ ((overloadable));
+
 /// Solution displayer signature
 /// @param [in] universe Universe
 /// @param [in] length Number of subsets in the solution
@@ -85,6 +294,16 @@ int dlx_subset_require_in_solution (Universe universe, const char *subset_name);
 /// @param [in] data Pointer to user defined and allocated data passed to \p dlx_displayer_set().
 typedef void (*dlx_solution_displayer) (Universe universe, unsigned long length, const char *const *solution, void *data);
 
+/// Gets the index of a subset of a solution.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of a subset, as passed to the solution displayer (see dlx_displayer_set()).
+/// @return Index of the subset (subsets are indexed from 0 in order of definition), or ULONG_MAX if \p subset_name is not a name of a subset of the universe.
+///
+/// For a name passed by the library (to a solution displayer, by dlx_sink_decode() or in a dlx_conflict), the index is found without comparing names,
+/// in time proportional to the number of blocks of storage of names only: solutions of models built by a program can be mapped back to their structure.
+/// Any other string (a copy of a name, for instance) is looked up in a hash table of names, in constant time on average (the first subset of that name is found.)
+unsigned long dlx_subset_index (Universe universe, const char *subset_name);
+
 /// Setter of solution displayer.
 /// @param [in] universe Universe
 /// @param [in] displayer Solution displayer to set.
@@ -92,7 +311,288 @@ typedef void (*dlx_solution_displayer) (Universe universe, unsigned long length,
 /// @return Solution displayer set by the previous call to dlx_displayer_set() (or \p NULL on first call).
 ///
 /// The function pointed to by \p displayer passed as an argument, if set, is called by dlx_exact_cover_search() every time a solution is found.
-dlx_solution_displayer dlx_displayer_set (Universe universe, dlx_solution_displayer displayer, void *data);
+dlx_solution_displayer dlx_displayer_set (Universe universe, dlx_solution_displayer displayer, void *data) __attribute__ ((overloadable));
+
+/// Setter of solution displayer of a search context.
+/// @param [in] context Search context
+/// @param [in] displayer Solution displayer to set.
+/// @param [in] data Pointer to user defined and allocated data passed.
+/// @return Solution displayer previously set (the one of the universe on first call).
+///
+/// A search context inherits the solution displayer of its universe at creation.
+dlx_solution_displayer dlx_displayer_set (SearchContext context, dlx_solution_displayer displayer, void *data) __attribute__ ((overloadable));
+
+/// Objet SolutionSink
+///
+/// A solution sink stores solutions in a compact binary form, instead of displaying them: high volumes of solutions
+/// can be written without the cost of formatting names and calling a solution displayer for each of them.
+/// Solutions are written as lists of indices of subsets (in order of definition), encoded as variable length integers,
+/// each one delta-encoded against the previous solution (solutions found in a row share long prefixes.)
+/// The encoded solutions are buffered, and the buffer is written by a writer when full.
+typedef struct solution_sink *SolutionSink;
+
+/// Solution writer signature
+/// @param [in] bytes Bytes to write.
+/// @param [in] size Number of bytes to write.
+/// @param [in] data Pointer to user defined and allocated data passed to \p dlx_sink_create().
+/// @return 1 if successful, 0 otherwise.
+typedef int (*dlx_sink_writer) (const void *bytes, unsigned long size, void *data);
+
+/// Initialises a new solution sink, written by a writer.
+/// @param [in] writer Writer of the buffer of the sink.
+/// @param [in] data Pointer to user defined and allocated data passed to \p writer.
+/// @param [in] capacity Capacity of the buffer, in bytes (0 for 1 MiB.)
+/// @return Solution sink, or 0 if \p writer is 0.
+/// @post User must call dlx_sink_destroy(SolutionSink sink) later.
+SolutionSink dlx_sink_create (dlx_sink_writer writer, void *data, unsigned long capacity) __attribute__ ((overloadable));
+
+/// Initialises a new solution sink, written to a file.
+/// @param [in] filename Name of the file (replaced if it exists.)
+/// @param [in] capacity Capacity of the buffer, in bytes (0 for 1 MiB.)
+/// @return Solution sink, or 0 if the file can not be created.
+/// @post User must call dlx_sink_destroy(SolutionSink sink) later.
+SolutionSink dlx_sink_create (const char *filename, unsigned long capacity) __attribute__ ((overloadable));
+
+/// Writes the solutions buffered by a solution sink.
+/// @param [in] sink Solution sink
+/// @return 1 if all solutions written to the sink so far were successfully written, 0 otherwise.
+int dlx_sink_flush (SolutionSink sink);
+
+/// Gets the number of solutions written to a solution sink.
+/// @param [in] sink Solution sink
+/// @return Number of solutions written to the sink since its creation.
+unsigned long dlx_sink_solutions (SolutionSink sink);
+
+/// Writes the solutions buffered by a solution sink and releases the sink.
+/// @param [in] sink Solution sink
+///
+/// Call dlx_sink_flush() before to check that all solutions were written.
+void dlx_sink_destroy (SolutionSink sink);
+
+/// Sets the solution sink of the search contexts created for a universe.
+/// @param [in] universe Universe
+/// @param [in] sink Solution sink (0 to display solutions.)
+/// @return Solution sink previously set.
+///
+/// Solutions found by searches are written to the sink instead of being traced and displayed.
+/// The solution displayer is still called once, with no solution, by searches which find no solution.
+SolutionSink dlx_sink_set (Universe universe, SolutionSink sink) __attribute__ ((overloadable));
+
+/// Sets the solution sink of a search context.
+/// @param [in] context Search context
+/// @param [in] sink Solution sink (0 to display solutions.)
+/// @return Solution sink previously set (the one of the universe on first call).
+///
+/// A search context inherits the solution sink of its universe at creation.
+/// A solution sink must not be used by several search contexts concurrently.
+SolutionSink dlx_sink_set (SearchContext context, SolutionSink sink) __attribute__ ((overloadable));
+
+/// Decodes the solutions written to a file by a solution sink.
+/// @param [in] universe Universe searched for the solutions (or a clone of it.)
+/// @param [in] filename Name of the file.
+/// @return Number of solutions decoded.
+///
+/// The solution displayer of the universe is called for every solution decoded, with the names of its subsets.
+/// Decoding stops at the end of the file or at the first malformed solution.
+unsigned long dlx_sink_decode (Universe universe, const char *filename);
+
+/// Sets tracing of execution on standard error terminal (for debugging purpose only).
+/// @param [in] universe Universe
+/// @param [in] trace Trace if set, keep quiet otherwise.
+/// @return Previous setting.
+///
+/// The default setting of a new universe is read from the environment variable \p DLX_TRACE (trace if set and not equal to "0").
+int dlx_trace_set (Universe universe, int trace) __attribute__ ((overloadable));
+
+/// Sets tracing of execution of a search context on standard error terminal (for debugging purpose only).
+/// @param [in] context Search context
+/// @param [in] trace Trace if set, keep quiet otherwise.
+/// @return Previous setting.
+///
+/// A search context inherits the setting of its universe at creation.
+int dlx_trace_set (SearchContext context, int trace) __attribute__ ((overloadable));
+
+/// Search engines
+enum dlx_engine {
+  DLX_ENGINE_LINKS = 0, ///< Dancing links: subsets and elements are doubly linked lists (default.)
+  DLX_ENGINE_CELLS,     ///< Dancing cells: subsets and elements are sparse sets, restored by resetting their sizes.
+  DLX_ENGINE_AUTO,      ///< Automatic selection of the engine, propagation and order of subsets, at the start of each search (see dlx_auto_choice().)
+};
+
+/// Orders in which the subsets containing the element chosen by the search are tried.
+enum dlx_subset_order {
+  DLX_ORDER_DEFINITION = 0,     ///< In order of definition (default.)
+  DLX_ORDER_SHORTEST,           ///< Subsets with the fewest elements first.
+  DLX_ORDER_LONGEST,            ///< Subsets with the most elements first.
+  DLX_ORDER_PRIORITY,           ///< Subsets with the highest priority first (see dlx_subset_priority_set()).
+  DLX_ORDER_LEAST_CONSTRAINING, ///< Subsets whose choice removes the fewest other subsets first.
+  DLX_ORDER_FAILURES,           ///< Subsets which led to the fewest branches without solution in the previous searches on the search context first.
+};
+
+/// Choice of the automatic selection of search strategies, with the statistics of the model it is based on.
+struct dlx_auto_choice {
+  unsigned long nb_elements;       ///< Number of elements to be covered.
+  unsigned long nb_subsets;        ///< Number of subsets which can be part of a solution.
+  unsigned long nb_cells;          ///< Number of elements of those subsets.
+  double density;                  ///< Fraction of the pairs of elements and subsets where the subset contains the element.
+  double mean_subset_length;       ///< Mean number of elements of subsets.
+  unsigned long max_subset_length; ///< Number of elements of the longest subset.
+  unsigned long min_element_size;  ///< Number of subsets containing the element contained in the fewest subsets.
+  unsigned long max_element_size;  ///< Number of subsets containing the element contained in the most subsets.
+  double mean_element_size;        ///< Mean number of subsets containing an element.
+
+  unsigned long calibration_nodes; ///< Budget of nodes of each calibration run (0 if none was run.)
+  double links_milliseconds;       ///< Time of the calibration run of the dancing links engine.
+  double cells_milliseconds;       ///< Time of the calibration run of the dancing cells engine (HUGE_VAL if it does not support the settings of the search.)
+  double propagation_milliseconds; ///< Time of the calibration run of the dancing links engine with propagation.
+  int calibration_complete;        ///< Set if a calibration run explored the whole search tree within the budget.
+
+  enum dlx_engine engine;              ///< Search engine chosen.
+  int propagation;                     ///< Propagation chosen.
+  enum dlx_subset_order subset_order;  ///< Order of subsets chosen.
+  unsigned long nb_workers;            ///< Number of worker processes recommended for dlx_jobs_search() (at least 1.)
+};
+
+/// Selects the search engine of the search contexts created for a universe.
+/// @param [in] universe Universe
+/// @param [in] engine Search engine
+/// @return Previous setting.
+///
+/// Both engines find the same solutions, and visit the same number of nodes when all solutions are searched for.
+/// The dancing cells engine builds its sparse sets at the start of each search, and accesses memory mostly sequentially.
+/// Searches with symmetries, propagation, checkpoints, jobs, progress reports, or for the solution of minimal cost,
+/// are run by the dancing links engine, whatever the setting.
+enum dlx_engine dlx_engine_set (Universe universe, enum dlx_engine engine) __attribute__ ((overloadable));
+
+/// Selects the search engine of a search context.
+/// @param [in] context Search context
+/// @param [in] engine Search engine
+/// @return Previous setting.
+///
+/// A search context inherits the setting of its universe at creation.
+enum dlx_engine dlx_engine_set (SearchContext context, enum dlx_engine engine) __attribute__ ((overloadable));
+
+/// Sets the budget of nodes of the calibration of the automatic selection of the search contexts created for a universe.
+/// @param [in] universe Universe
+/// @param [in] nodes Number of nodes of each calibration run (0 for no calibration.)
+/// @return Previous setting.
+///
+/// With DLX_ENGINE_AUTO, searches first inspect the model (numbers of elements and subsets, density, lengths of subsets,
+/// numbers of subsets containing elements). With a budget of nodes, they then run the search for at most that many nodes
+/// with each engine, and with propagation, without reporting solutions, and choose the fastest.
+unsigned long dlx_auto_calibration_set (Universe universe, unsigned long nodes) __attribute__ ((overloadable));
+
+/// Sets the budget of nodes of the calibration of the automatic selection of a search context.
+/// @param [in] context Search context
+/// @param [in] nodes Number of nodes of each calibration run (0 for no calibration.)
+/// @return Previous setting.
+///
+/// A search context inherits the setting of its universe at creation.
+unsigned long dlx_auto_calibration_set (SearchContext context, unsigned long nodes) __attribute__ ((overloadable));
+
+/// Gets the choice of the automatic selection of the last search on a universe.
+/// @param [in] universe Universe
+/// @return Choice (owned by the universe), or 0 if the last search was not run with DLX_ENGINE_AUTO.
+///
+/// The choice is also traced (see dlx_trace_set()).
+/// In the automatic mode, propagation is chosen for each search (the user setting applies to searches with checkpoints), without changing the setting of dlx_propagation_set().
+/// The choice of elements is the same for all engines (the element in the fewest subsets first). Searches for the first solution try
+/// the least constraining subsets first (see dlx_subset_order_set()), unless another order of subsets was set, or the search is resumed or split into jobs.
+/// The calibration runs on a scratch search context with the settings of the search: it neither reports solutions, events or progress, nor records nogoods or failures.
+/// It is only run again by a later search on the same search context once the model, the settings of the search or the budget changed.
+/// The dancing cells engine is neither tried nor chosen when the settings of the search need the links between elements.
+/// The recommended number of worker processes is not used by dlx_exact_cover_search(), which runs in the calling process:
+/// it is meant for dlx_jobs_search().
+const struct dlx_auto_choice *dlx_auto_choice (Universe universe) __attribute__ ((overloadable));
+
+/// Gets the choice of the automatic selection of the last search on a search context.
+/// @param [in] context Search context
+/// @return Choice (owned by the search context), or 0 if no search was run with DLX_ENGINE_AUTO.
+const struct dlx_auto_choice *dlx_auto_choice (SearchContext context) __attribute__ ((overloadable));
+
+/// Selects the order in which the search contexts created for a universe try subsets.
+/// @param [in] universe Universe
+/// @param [in] order Order of subsets
+/// @return Previous setting.
+///
+/// The order matters for the first solutions found (for instance with \p one_only set), not for the number of nodes of a search of all solutions.
+/// Subsets are ordered once at the start of each search (ties in order of definition), not at each node: the order of least constraining subsets
+/// is the one at the start of the search, and branches without solution are counted during each search, to order the next ones.
+/// The order is part of the fingerprint of checkpoints and jobs: they can only be resumed with the same order (and the same priorities with DLX_ORDER_PRIORITY.)
+/// With DLX_ORDER_FAILURES, the order depends on the history of the search context and can not be reproduced:
+/// searches which save or resume checkpoints (see dlx_checkpoint_set()), and jobs, try subsets in order of definition instead.
+/// The dancing cells engine numbers its options in the order they are first reached, so that it follows the order of subsets less closely.
+enum dlx_subset_order dlx_subset_order_set (Universe universe, enum dlx_subset_order order) __attribute__ ((overloadable));
+
+/// Selects the order in which a search context tries subsets.
+/// @param [in] context Search context
+/// @param [in] order Order of subsets
+/// @return Previous setting.
+///
+/// A search context inherits the setting of its universe at creation.
+enum dlx_subset_order dlx_subset_order_set (SearchContext context, enum dlx_subset_order order) __attribute__ ((overloadable));
+
+/// Sets the priority of a subset, for DLX_ORDER_PRIORITY.
+/// @param [in] universe Universe
+/// @param [in] subset_name Name of the subset (all the subsets with that name are set.)
+/// @param [in] priority Priority (0 by default.)
+/// @return 1 if the subset is known, 0 otherwise (or if it was merged into an identical subset, see dlx_duplicates_merge_set().)
+int dlx_subset_priority_set (Universe universe, const char *subset_name, double priority);
+
+/// Initialises a new search context on a universe.
+/// @param [in] universe Universe
+/// @return Search context
+/// @post User must call dlx_search_context_destroy(SearchContext context) later.
+///
+/// The search context works on its own copy of the links of the universe, as defined at the time of creation of the search context.
+/// The universe is not modified by searches on the search context and can therefore be shared by several search contexts used concurrently.
+/// The universe must not be modified (nor destroyed) while search contexts on it are in use.
+SearchContext dlx_search_context_create (const struct universe *universe);
+
+/// Releases data used by the search context.
+/// @param [in] context Search context
+void dlx_search_context_destroy (SearchContext context);
+
+/// Memory policies of the links of search contexts (flags, which can be combined.)
+enum dlx_memory_policy {
+  DLX_MEMORY_DEFAULT = 0,             ///< Allocated by malloc (default.)
+  DLX_MEMORY_HUGE_PAGES = 1,          ///< Backed by transparent huge pages, where the system allows it.
+  DLX_MEMORY_EXPLICIT_HUGE_PAGES = 2, ///< Backed by huge pages reserved by the system administrator (transparent huge pages if none is left.)
+  DLX_MEMORY_INTERLEAVE = 4,          ///< Interleaved over the NUMA nodes.
+  DLX_MEMORY_LOCAL = 8,               ///< On the NUMA node of the thread creating the search context.
+};
+
+/// Selects the memory policy of the links of the search contexts created for a universe.
+/// @param [in] universe Universe
+/// @param [in] policy Memory policy, as flags of \p enum \p dlx_memory_policy.
+/// @return Previous setting.
+///
+/// The links of a search context (the links between elements and the numbers of subsets containing elements) are the memory read
+/// and written by the search at every node: huge pages reduce the misses of the TLB on large models, and NUMA policies the traffic between sockets.
+/// With DLX_MEMORY_LOCAL, each worker thread should create its own search context, which is then a local replica of the links.
+/// The links are copied, hence faulted in, when the search context is created, after the policy is applied: searches do not fault them in.
+/// Links backed by huge pages are rounded up to a multiple of the size of huge pages reported by the system.
+/// Policies which can not be applied (not supported by the system, or no huge pages left) are ignored.
+int dlx_memory_policy_set (Universe universe, int policy);
+
+/// Memory statistics of a search context.
+///
+/// Page faults are counted per thread on Linux, and for the whole process elsewhere (they then include those of concurrent threads.)
+struct dlx_memory_statistics {
+  unsigned long bytes;           ///< Number of bytes of the links of the search context.
+  unsigned long huge_page_bytes; ///< Number of bytes of the links backed by huge pages, as reported by the system (0 if unknown.)
+  int policy;                    ///< Memory policy applied to the links (the policies which could not be applied are cleared.)
+  unsigned long creation_faults; ///< Number of page faults of the thread creating the search context while it was created.
+  unsigned long search_faults;   ///< Number of page faults of the thread searching during the last search on the search context.
+};
+
+/// Gets the memory statistics of a search context.
+/// @param [in] context Search context
+/// @return Statistics (owned by the search context.)
+///
+/// The huge pages backing the links are read from the system by the first call after the creation of the search context and after each search:
+/// further calls return the same statistics.
+const struct dlx_memory_statistics *dlx_memory_statistics (SearchContext context);
 
 /// Searches for all exact cover solutions.
 /// @param [in] universe Universe
@@ -107,15 +607,435 @@ dlx_solution_displayer dlx_displayer_set (Universe universe, dlx_solution_displa
 ///
 /// If dlx_displayer_set() was not called or was called with an argument equal to 0, solutions are displayed on standard terminal output.
 ///
-unsigned long dlx_exact_cover_search (Universe universe, int one_only);
+/// If symmetries were declared with dlx_symmetry_define(), only canonical solutions are searched for, displayed and counted.
+unsigned long dlx_exact_cover_search (Universe universe, int one_only) __attribute__ ((overloadable));
+
+/// Searches for all exact cover solutions, on a search context.
+/// @param [in] context Search context
+/// @param [in] one_only If set, searches for the first solution only.
+/// @return Number of solutions found.
+///
+/// Same as dlx_exact_cover_search(Universe universe, int one_only), using the solution displayer of the search context.
+/// The universe of the search context is left unchanged. Searches on distinct search contexts can be run concurrently.
+unsigned long dlx_exact_cover_search (SearchContext context, int one_only) __attribute__ ((overloadable));
+
+/// Gets the number of solutions found by the last search, symmetric images included.
+/// @param [in] universe Universe
+/// @return Number of solutions found by the last call to dlx_exact_cover_search().
+///
+/// If symmetries were declared with dlx_symmetry_define(), dlx_exact_cover_search() returns (and displays) canonical solutions only,
+/// and this number counts every solution of each class of equivalence.
+/// If identical subsets were merged (see dlx_duplicates_merge_set()), every solution counts as many solutions as the product of the multiplicities of its subsets.
+/// Otherwise, it is equal to the number returned by dlx_exact_cover_search().
+unsigned long dlx_solutions_total (Universe universe) __attribute__ ((overloadable));
+
+/// Gets the number of solutions found by the last search on a search context, symmetric images included.
+/// @param [in] context Search context
+/// @return Number of solutions found by the last call to dlx_exact_cover_search(SearchContext context, int one_only).
+unsigned long dlx_solutions_total (SearchContext context) __attribute__ ((overloadable));
+
+/// Searches for the exact cover solution of minimal cost of a universe.
+/// @param [in] universe Universe
+/// @return 1 if a solution was found, 0 otherwise.
+///
+/// The cost of a solution is the sum of the weights of its subsets, required subsets included (see dlx_subset_define()).
+/// The search keeps the best solution found so far, and prunes the branches whose cost can not be lower,
+/// according to a lower bound of the cost of the elements still to be covered (the sum of their cheapest share of the weight of a subset).
+/// Only the solution of minimal cost (the first one found, in case of ties) is displayed, at the end of the search.
+/// Symmetries are not used (weights might not be symmetric.)
+unsigned long dlx_exact_cover_optimize (Universe universe) __attribute__ ((overloadable));
+
+/// Searches for the exact cover solution of minimal cost on a search context.
+/// @param [in] context Search context
+/// @return 1 if a solution was found, 0 otherwise.
+///
+/// If the search is stopped (see dlx_checkpoint_request()), the best solution found so far is displayed.
+/// Checkpoints are not saved by this search.
+unsigned long dlx_exact_cover_optimize (SearchContext context) __attribute__ ((overloadable));
+
+/// Gets the cost of the solution found by the last call to dlx_exact_cover_optimize() on a universe.
+/// @param [in] universe Universe
+/// @return Cost of the solution of minimal cost, HUGE_VAL if none was found.
+double dlx_solution_cost (Universe universe) __attribute__ ((overloadable));
+
+/// Gets the cost of the solution found by the last call to dlx_exact_cover_optimize() on a search context.
+/// @param [in] context Search context
+/// @return Cost of the solution of minimal cost, HUGE_VAL if none was found.
+double dlx_solution_cost (SearchContext context) __attribute__ ((overloadable));
+
+/// Sets the maximal length of the solutions of the search contexts created for a universe.
+/// @param [in] universe Universe
+/// @param [in] max_length Maximal number of subsets in solutions, required subsets included (0 if unlimited.)
+/// @return Previous maximal length.
+///
+/// Searches prune the branches whose elements left can not be covered within the maximal length,
+/// according to a lower bound of the number of subsets still needed (the number of elements left divided by the number of elements of the longest subset.)
+unsigned long dlx_solution_length_max_set (Universe universe, unsigned long max_length) __attribute__ ((overloadable));
+
+/// Sets the maximal length of the solutions of the searches on a search context.
+/// @param [in] context Search context
+/// @param [in] max_length Maximal number of subsets in solutions, required subsets included (0 if unlimited.)
+/// @return Previous maximal length.
+unsigned long dlx_solution_length_max_set (SearchContext context, unsigned long max_length) __attribute__ ((overloadable));
+
+/// Searches for the exact cover solutions of minimal length (fewest subsets) of a universe.
+/// @param [in] universe Universe
+/// @param [in] one_only Stops after the first solution found if 1.
+/// @return Number of solutions of minimal length found.
+///
+/// The maximal length of solutions is increased (iterative deepening) from its lower bound until solutions are found,
+/// up to the maximal length set by dlx_solution_length_max_set(), if any.
+/// Only the solutions of minimal length are displayed.
+unsigned long dlx_exact_cover_search_shortest (Universe universe, int one_only) __attribute__ ((overloadable));
+
+/// Searches for the exact cover solutions of minimal length (fewest subsets) on a search context.
+/// @param [in] context Search context
+/// @param [in] one_only Stops after the first solution found if 1.
+/// @return Number of solutions of minimal length found.
+///
+/// The number of nodes of the search counts all the searches of the deepening. Checkpoints are not saved by this search.
+unsigned long dlx_exact_cover_search_shortest (SearchContext context, int one_only) __attribute__ ((overloadable));
+
+/// Sets propagation of the searches on a universe.
+/// @param [in] universe Universe
+/// @param [in] propagation Propagate if set (unset by default.)
+/// @return Previous setting.
+///
+/// With propagation, right after each choice of a subset, the subsets which are the only ones left for an element
+/// are taken into the solution at once (forced subsets), and the choice is given up as soon as an element is left in no subset (dead end).
+/// Forced subsets and dead ends are not counted as nodes of the search. Solutions are found in the same order as without propagation.
+int dlx_propagation_set (Universe universe, int propagation) __attribute__ ((overloadable));
+
+/// Sets propagation of the searches on a search context.
+/// @param [in] context Search context
+/// @param [in] propagation Propagate if set.
+/// @return Previous setting.
+///
+/// A search context inherits the setting of its universe at creation.
+int dlx_propagation_set (SearchContext context, int propagation) __attribute__ ((overloadable));
+
+/// Gets the number of subsets forced by propagation during the last search on a universe.
+/// @param [in] universe Universe
+/// @return Number of forced subsets.
+unsigned long dlx_propagation_forced (Universe universe) __attribute__ ((overloadable));
+
+/// Gets the number of subsets forced by propagation during the last search on a search context.
+/// @param [in] context Search context
+/// @return Number of forced subsets.
+unsigned long dlx_propagation_forced (SearchContext context) __attribute__ ((overloadable));
+
+/// Gets the number of dead ends detected by propagation during the last search on a universe.
+/// @param [in] universe Universe
+/// @return Number of choices given up.
+unsigned long dlx_propagation_dead_ends (Universe universe) __attribute__ ((overloadable));
+
+/// Gets the number of dead ends detected by propagation during the last search on a search context.
+/// @param [in] context Search context
+/// @return Number of choices given up.
+unsigned long dlx_propagation_dead_ends (SearchContext context) __attribute__ ((overloadable));
+
+/// Progress of a search, as reported to the progress reporter.
+struct dlx_search_progress {
+  unsigned long depth;     ///< Depth of the current node of the search tree.
+  unsigned long nodes;     ///< Number of nodes of the search tree visited so far.
+  unsigned long solutions; ///< Number of solutions found so far.
+  unsigned long levels;    ///< Number of top levels of the search described by \p position and \p branches (at most 16.)
+  const unsigned long *position; ///< Position (from 0) of the subset tried at each of the top \p levels levels, among the \p branches subsets.
+  const unsigned long *branches; ///< Number of subsets to be tried at each of the top \p levels levels.
+  double fraction;         ///< Estimated fraction of the search tree explored so far, between 0 and 1 (assuming all branches of a level weigh the same.)
+};
+
+/// Progress reporter signature
+/// @param [in] context Search context
+/// @param [in] progress Progress of the search
+/// @param [in] data Pointer to user defined and allocated data passed to \p dlx_progress_set().
+///
+/// For instance, "subset 3 of 12 at level 0" is reported as position[0] = 2 and branches[0] = 12.
+typedef void (*dlx_progress_reporter) (SearchContext context, const struct dlx_search_progress *progress, void *data);
+
+/// Setter of progress reporter of a search context.
+/// @param [in] context Search context
+/// @param [in] reporter Progress reporter to set (0 to report nothing.)
+/// @param [in] data Pointer to user defined and allocated data passed.
+/// @param [in] nodes Number of nodes of the search tree visited between two reports (0 to report periodically in time only.)
+/// @param [in] milliseconds Time between two reports (0 to report periodically in nodes only.)
+/// @return Progress reporter previously set (or \p NULL.)
+///
+/// The function pointed to by \p reporter is called by dlx_exact_cover_search(SearchContext context, int one_only) every \p nodes nodes
+/// and every \p milliseconds milliseconds (the clock is read every few thousand nodes). Searches are not slowed down if no reporter is set.
+dlx_progress_reporter dlx_progress_set (SearchContext context, dlx_progress_reporter reporter, void *data, unsigned long nodes, unsigned long milliseconds);
+
+/// Events of a search
+enum dlx_search_event {
+  DLX_EVENT_PUSH,     ///< A subset is added to the solution.
+  DLX_EVENT_POP,      ///< The last subset added to the solution is removed.
+  DLX_EVENT_SOLUTION, ///< The subsets in the solution make a solution.
+};
+
+/// Search event handler signature
+/// @param [in] context Search context
+/// @param [in] event Event
+/// @param [in] depth Position of the subset added or removed in the solution (from 0, subsets required in solutions first), or length of the solution found.
+/// @param [in] subset Index of the subset added or removed, in order of definition (ULONG_MAX for a solution.)
+/// @param [in] name Name of the subset added or removed (0 for a solution.)
+/// @param [in] data Pointer to user defined and allocated data passed to \p dlx_events_set().
+typedef void (*dlx_search_event_handler) (SearchContext context, enum dlx_search_event event, unsigned long depth, unsigned long subset,
+                                          const char *name, void *data);
+
+/// Setter of search event handler of a search context.
+/// @param [in] context Search context
+/// @param [in] handler Search event handler to set (0 to notify nothing.)
+/// @param [in] data Pointer to user defined and allocated data passed.
+/// @return Search event handler previously set (or \p NULL.)
+///
+/// The function pointed to by \p handler is notified by dlx_exact_cover_search(SearchContext context, int one_only) of the search tree as it is explored:
+/// every subset added to the solution is pushed, and popped when it is removed, and every solution found is notified between them,
+/// so that solutions can be gathered into a tree (or aggregated) in time linear in the size of the search tree,
+/// instead of rebuilding every solution from scratch. Subsets required in solutions are pushed first and popped last.
+/// With symmetries, only canonical solutions are notified. Searches for the solution of minimal cost notify every solution which improves the best one.
+dlx_search_event_handler dlx_events_set (SearchContext context, dlx_search_event_handler handler, void *data);
+
+/// Gets the number of nodes of the search tree visited by the last search on a search context.
+/// @param [in] context Search context
+/// @return Number of nodes visited (including nodes visited before the checkpoint the search was resumed from.)
+unsigned long dlx_search_nodes (SearchContext context);
+
+/// Gets the number of updates of links made by the last search on a search context.
+/// @param [in] context Search context
+/// @return Number of elements of subsets removed from or restored to the sparse matrix of elements and subsets.
+unsigned long dlx_search_updates (SearchContext context);
+
+/// Sets the capacity of the store of nogoods of a search context.
+/// @param [in] context Search context
+/// @param [in] capacity Number of nogoods the store can hold (rounded up to a power of 2, 0 to record no nogood, by default.)
+/// @return Previous capacity.
+///
+/// The subproblem left at a node of the search tree only depends on the elements covered by the subsets chosen above it,
+/// whatever the order they were chosen in. With a store of nogoods, the sets of covered elements whose subproblem was found
+/// to have no solution are recorded (as 128-bit hashes), and branches which would cover the same set of elements again are pruned.
+/// The store is bounded: when it is full, older nogoods are replaced. It is kept between searches on the search context, and cleared by this function.
+/// Nogoods are recorded by the dancing links engine (whatever the setting of dlx_engine_set()), with or without propagation, both for the first solution
+/// and for all solutions. They are not used by searches with symmetries, limited lengths, resumed searches, jobs, or for the solution of minimal cost.
+unsigned long dlx_nogoods_set (SearchContext context, unsigned long capacity);
+
+/// Statistics of the store of nogoods of a search context.
+struct dlx_nogood_statistics {
+  unsigned long capacity; ///< Number of nogoods the store can hold.
+  unsigned long stored;   ///< Number of nogoods in the store.
+  unsigned long lookups;  ///< Number of nodes looked up in the store during the last search.
+  unsigned long hits;     ///< Number of nodes pruned by a nogood during the last search (the hit rate is hits / lookups.)
+  unsigned long recorded; ///< Number of nogoods recorded during the last search.
+  unsigned long replaced; ///< Number of nogoods replaced by newer ones during the last search.
+};
+
+/// Gets the statistics of the store of nogoods of a search context.
+/// @param [in] context Search context
+/// @return Statistics (owned by the search context.)
+const struct dlx_nogood_statistics *dlx_nogood_statistics (SearchContext context);
+
+/// Settings of the random sampling of solutions on a search context.
+/// @param [in] context Search context
+/// @param [in] nb_probes Number of random probes of the search tree reaching a solution per solution drawn (64 by default, at least 1.)
+/// @param [in] exact_nodes Budget of nodes of the exact counts of the solutions of subtrees (10000 by default, 0 for no exact count.)
+/// @param [in] seed Seed of the pseudo-random generator (1 by default.)
+///
+/// See dlx_exact_cover_sample().
+void dlx_sampling_set (SearchContext context, unsigned long nb_probes, unsigned long exact_nodes, unsigned long seed);
+
+/// Draws solutions of a search context at random, uniformly (exactly or approximately).
+/// @param [in] context Search context
+/// @param [in] nb_samples Number of solutions to draw.
+/// @return Number of solutions drawn (less than \p nb_samples only if no solution was reached by many probes in a row, for instance if the universe has no solution.)
+///
+/// Each solution drawn is displayed (or written to the solution sink) as solutions found by dlx_exact_cover_search(SearchContext context, int one_only).
+/// A solution is drawn out of random probes of the search tree: each probe goes down the tree, choosing a subset at random
+/// among the subsets of the element with fewest subsets, and reaches a solution with a known probability p, or a dead end.
+/// The solution drawn is picked among the solutions reached with probabilities proportional to 1/p (sampling importance resampling),
+/// which tends to the uniform distribution as the number of probes grows: the bias is of the order of 1/dlx_sampling_quality()->effective_probes.
+/// Subtrees small enough to be counted within the budget of nodes are counted exactly, and their solutions drawn uniformly:
+/// if the whole search tree is small enough, solutions are drawn exactly uniformly (dlx_sampling_quality()->exact.)
+/// The level of the search tree from which subtrees are counted is adapted from probe to probe, and kept between calls, so that many
+/// solutions are drawn efficiently from the same search context.
+///
+/// Solutions are drawn among all solutions, symmetric images included, merged identical subsets counted with their multiplicity.
+unsigned long dlx_exact_cover_sample (SearchContext context, unsigned long nb_samples);
+
+/// Quality of the solutions drawn by the last call to dlx_exact_cover_sample().
+struct dlx_sampling_quality {
+  unsigned long probes;       ///< Number of probes of the search tree (reaching a solution or not.)
+  unsigned long successes;    ///< Number of probes which reached a solution.
+  double effective_probes;    ///< Smallest effective number of probes of a solution drawn, (Σw)²/Σw² for the weights w = 1/p of the probes (HUGE_VAL if exact.)
+  double estimated_solutions; ///< Estimated number of solutions of the universe, merged identical subsets included (mean of the weights of the probes.)
+  int exact;                  ///< Set if the whole search tree was counted: solutions were then drawn exactly uniformly, and \p estimated_solutions is exact.
+};
+
+/// Gets the quality of the solutions drawn by the last call to dlx_exact_cover_sample().
+/// @param [in] context Search context
+/// @return Quality (owned by the search context.)
+const struct dlx_sampling_quality *dlx_sampling_quality (SearchContext context);
+
+/// Saves the frontier of searches on a search context to a file, periodically and on request.
+/// @param [in] context Search context
+/// @param [in] filename Name of the checkpoint file (0 to stop saving checkpoints.)
+/// @param [in] interval Number of nodes of the search tree visited between two checkpoints (0 to save checkpoints on request only.)
+/// @return 1 if successful, 0 otherwise.
+///
+/// The frontier of a search is the subset chosen at each level of the search above the current node,
+/// together with the counters of nodes and solutions. The file is replaced atomically at each checkpoint,
+/// and records the completion of the search when it ends.
+int dlx_checkpoint_set (SearchContext context, const char *filename, unsigned long interval);
+
+/// Requests a checkpoint of the search running on a search context.
+/// @param [in] context Search context
+/// @param [in] stop If set, the search is stopped right after the checkpoint.
+///
+/// The checkpoint is saved at the next node of the search tree, in the file set by dlx_checkpoint_set().
+/// This function is async-signal-safe: it can be called from a signal handler, for instance on \p SIGTERM
+/// when the process is about to be preempted.
+void dlx_checkpoint_request (SearchContext context, int stop);
+
+/// Prepares a search context to resume a search from a checkpoint.
+/// @param [in] context Search context
+/// @param [in] filename Name of the checkpoint file saved by a previous search.
+/// @return 1 if the checkpoint was read successfully, 0 otherwise (unreadable file or checkpoint of another model.)
+///
+/// The next call to dlx_exact_cover_search(SearchContext context, int one_only) resumes the search exactly where the checkpoint was saved:
+/// solutions found before the checkpoint are counted but not displayed again.
+/// The universe of the search context must be the same (same elements, subsets, required subsets and symmetries, defined in the same order)
+/// as the one of the search which saved the checkpoint.
+int dlx_checkpoint_resume (SearchContext context, const char *filename);
+
+/// Checks whether the last search on a search context was stopped before completion.
+/// @param [in] context Search context
+/// @return 1 if the last search was stopped by dlx_checkpoint_request() (or the last merge of jobs was incomplete), 0 otherwise.
+int dlx_search_interrupted (SearchContext context);
+
+/// Splits a search into independent jobs, saved as files.
+/// @param [in] context Search context
+/// @param [in] depth Number of levels of the search fixed by each job.
+/// @param [in] prefix Prefix of the names of the job files: jobs are saved in files \p prefix.0.job, \p prefix.1.job, ...
+/// @return Number of jobs saved.
+///
+/// Each job is the subtree of a node of the search tree at depth \p depth, identified by the subsets chosen at the levels above it
+/// (solutions found above this depth are saved as jobs as well.) Jobs are saved in the format of checkpoints
+/// and can be run separately, by other processes, with dlx_job_run().
+/// The search is split with the order of subsets and the propagation setting of the search context, which jobs are run with.
+unsigned long dlx_jobs_split (SearchContext context, unsigned long depth, const char *prefix);
+
+/// Runs a job saved by dlx_jobs_split().
+/// @param [in] context Search context, on the same universe as the one which split the search.
+/// @param [in] job Name of the job file.
+/// @param [in] result Name of the file where the solutions and the counters of the job are saved.
+/// @return 1 if the job was completed, 0 otherwise.
+///
+/// Solutions are not displayed but recorded in the result file, which is only written when the job is completed.
+/// A job interrupted by dlx_checkpoint_request() is therefore run again from its start.
+int dlx_job_run (SearchContext context, const char *job, const char *result);
+
+/// Merges the results of the jobs saved by dlx_jobs_split().
+/// @param [in] context Search context, on the same universe as the one which split the search.
+/// @param [in] prefix Prefix of the names of the job files, as passed to dlx_jobs_split().
+/// @param [in] nb_jobs Number of jobs, as returned by dlx_jobs_split().
+/// @return Number of solutions found by the jobs.
+///
+/// The solution displayer of the search context is called for every solution found by the jobs, read from the files \p prefix.0.result, \p prefix.1.result, ...
+/// (or the solution is written to the solution sink of the search context, if any: jobs record their solutions in their result files, not in the sink.)
+/// Counters are summed, as if the search had been run on the search context (see dlx_solutions_total()).
+/// If the result of some job is missing, the merge is incomplete and dlx_search_interrupted() returns 1.
+unsigned long dlx_jobs_merge (SearchContext context, const char *prefix, unsigned long nb_jobs);
+
+/// Searches for all exact cover solutions with local worker processes.
+/// @param [in] context Search context
+/// @param [in] depth Number of levels of the search fixed by each job.
+/// @param [in] prefix Prefix of the names of the job files.
+/// @param [in] nb_workers Number of worker processes (0 is taken as 1.)
+/// @return Number of solutions found.
+///
+/// Local coordinator: splits the search into jobs with dlx_jobs_split(), runs them in \p nb_workers forked processes with dlx_job_run(),
+/// merges their results with dlx_jobs_merge(), and removes the job files (unless the merge is incomplete.)
+unsigned long dlx_jobs_search (SearchContext context, unsigned long depth, const char *prefix, unsigned long nb_workers);
+
+/// Builds a generalized sudoku.
+/// @param [in] n Size of the boxes: the grid has n² rows, n² columns and n² boxes of n×n cells, filled with digits from 1 to n².
+/// @param [in] nb_regions Number of extra regions (for instance 2 for the diagonals of a sudoku X), which must also hold every digit once.
+/// @param [in] regions Indices (row × n² + column, from 0) of the n² distinct cells of each extra region, region after region.
+/// @return Universe of the empty grid, or 0 if the arguments are invalid.
+/// @post User must call dlx_universe_destroy(Universe universe) later.
+///
+/// The subset which puts the digit d in the cell of row r and column c (all from 1) is named "R<r>C<c>#<d>",
+/// so that the initial digits of a grid are required in solutions with dlx_subset_require_in_solution().
+/// Its index is ((r - 1) × n² + c - 1) × n² + d - 1: solutions are mapped back to grids by dlx_sudoku_decode().
+Universe dlx_sudoku_create (unsigned long n, unsigned long nb_regions, const unsigned long regions[]);
+
+/// Fills a grid from a solution of a sudoku built by dlx_sudoku_create().
+/// @param [in] universe Universe, as passed to the solution displayer.
+/// @param [in] n Size of the boxes, as passed to dlx_sudoku_create().
+/// @param [in] length Number of subsets in the solution
+/// @param [in] solution Names of the subsets in the solution, as passed to the solution displayer.
+/// @param [out] grid The n⁴ digits of the grid (from 1), row after row (0 for cells not filled by the solution.)
+/// @return 1 if successful, 0 otherwise (some subset is not a subset of the sudoku.)
+int dlx_sudoku_decode (Universe universe, unsigned long n, unsigned long length, const char *const *solution, unsigned long grid[]);
+
+/// Builds the N-queens problem.
+/// @param [in] n Size of the board: n queens are placed on a n×n board, one per row and column, and at most one per diagonal.
+/// @return Universe, or 0 if \p n is 0.
+/// @post User must call dlx_universe_destroy(Universe universe) later.
+///
+/// Rows and columns are elements of the universe to be covered. Diagonals are disabled elements (see dlx_element_disable()), covered at most once.
+/// The subset which puts a queen in row r and column c (from 1) is named "R<r>C<c>", and its index is (r - 1) × n + c - 1.
+Universe dlx_queens_create (unsigned long n);
+
+/// Gets the positions of the queens of a solution of the N-queens problem built by dlx_queens_create().
+/// @param [in] universe Universe, as passed to the solution displayer.
+/// @param [in] n Size of the board, as passed to dlx_queens_create().
+/// @param [in] length Number of subsets in the solution
+/// @param [in] solution Names of the subsets in the solution, as passed to the solution displayer.
+/// @param [out] columns Column (from 0) of the queen of each of the n rows (ULONG_MAX for rows without queen.)
+/// @return 1 if successful, 0 otherwise (some subset is not a subset of the N-queens problem.)
+int dlx_queens_decode (Universe universe, unsigned long n, unsigned long length, const char *const *solution, unsigned long columns[]);
+
+/// Cell of a board or of a piece of a polyomino (or polycube) packing.
+struct dlx_cell {
+  long x; ///< Coordinate along the first axis.
+  long y; ///< Coordinate along the second axis.
+  long z; ///< Coordinate along the third axis (0 for polyominoes.)
+};
+
+/// Piece of a polyomino (or polycube) packing.
+struct dlx_piece {
+  const char *name;             ///< Name of the piece (and of its element in the universe.)
+  unsigned long nb_cells;       ///< Number of cells of the piece.
+  const struct dlx_cell *cells; ///< Cells of the piece, in any position.
+};
+
+/// Builds the packing of polyominoes (or polycubes) on a board of any shape.
+/// @param [in] nb_cells Number of cells of the board.
+/// @param [in] board Cells of the board.
+/// @param [in] nb_pieces Number of pieces.
+/// @param [in] pieces Pieces, each used exactly once.
+/// @param [in] dimensions 2 for polyominoes (pieces are rotated in the plane (x, y)), 3 for polycubes (pieces are rotated in space.)
+/// @param [in] reflections 1 if pieces can also be reflected (turned over), 0 otherwise.
+/// @return Universe, or 0 if the arguments are invalid.
+/// @post User must call dlx_universe_destroy(Universe universe) later.
+///
+/// The elements of the universe are the pieces, then the cells of the board (indexed from \p nb_pieces in order of \p board.)
+/// The distinct orientations of the pieces are generated, and every placement of each orientation on the board is a subset,
+/// which contains its piece first and then the cells it covers. Solutions are mapped back to boards by dlx_polyomino_decode().
+Universe dlx_polyomino_create (unsigned long nb_cells, const struct dlx_cell board[], unsigned long nb_pieces, const struct dlx_piece pieces[],
+                               unsigned int dimensions, int reflections);
+
+/// Gets the piece covering every cell of the board of a solution of a packing built by dlx_polyomino_create().
+/// @param [in] universe Universe, as passed to the solution displayer.
+/// @param [in] nb_pieces Number of pieces, as passed to dlx_polyomino_create().
+/// @param [in] length Number of subsets in the solution
+/// @param [in] solution Names of the subsets in the solution, as passed to the solution displayer.
+/// @param [out] board Index of the piece covering each cell of the board (ULONG_MAX for cells not covered by the solution.)
+/// @return 1 if successful, 0 otherwise (some subset is not a subset of the packing.)
+int dlx_polyomino_decode (Universe universe, unsigned long nb_pieces, unsigned long length, const char *const *solution, unsigned long board[]);
 
 /// Releases data used by the universe.
 /// @param [in] universe Universe
 /// @pre Use dlx_universe_create(const char *elements, const char *separators) or dlx_universe_create(unsigned long nb_elements, const char *elements[]) first.
 void dlx_universe_destroy (Universe universe);
 
-/// Flag to trace execution on standard error terminal (for debugging purpose only).
-/// Trace if set, keep quiet otherwise (default).
-extern int dlx_trace;
-
 #endif
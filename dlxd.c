@@ -0,0 +1,625 @@
+/// Exact cover solver daemon.
+///
+/// Loads named models once, keeps them in memory, and answers search requests on a Unix domain socket,
+/// so that requests only pay for the search: neither for the start of a process nor for the construction of the universe.
+///
+/// Usage: dlxd socket [workers]
+///
+/// Connections are served by a pool of \p workers threads (the number of processors by default).
+/// Every request is a line of words separated by spaces, answered by lines ending with a line starting with "ok" or "error":
+/// - load model file: loads (or replaces) the model \p model from the file \p file (see below).
+/// - sudoku model n, queens model n: builds the model \p model with dlx_sudoku_create() or dlx_queens_create().
+/// - unload model: releases the model \p model (once the requests running on it are completed).
+/// - models: lists the loaded models, one per line ("model name").
+/// - count model [options]: counts the solutions of \p model.
+/// - first model [options]: searches for the first solution of \p model ("solution" followed by the names of its subsets).
+/// - search model [options]: searches for all the solutions of \p model, one per line.
+/// - quit: closes the connection.
+///
+/// Searches answer "ok solutions <number> total <number> nodes <number> interrupted <0 or 1>". Options are:
+/// - nodes=N: the search is stopped after about N nodes.
+/// - ms=T: the search is stopped after about T milliseconds.
+/// - require=subset: the subset is required in solutions (repeatable.)
+/// - engine=links, engine=cells or engine=auto: search engine (see dlx_engine_set()).
+/// - propagation: forced subsets are taken at once (see dlx_propagation_set()).
+///
+/// Each request runs on its own search context: models are shared read-only by the workers.
+/// Requests with required subsets run on a clone of the model (see dlx_universe_clone()).
+///
+/// SIGINT and SIGTERM stop the daemon: open connections are shut down, and running searches are stopped (they answer "interrupted 1").
+///
+/// Model files hold one declaration per line ('#' starts a comment line):
+/// - elements name...: elements of the universe (the universe is unbound if omitted.)
+/// - merge: identical subsets defined next are merged (see dlx_duplicates_merge_set()).
+/// - subset name element...: subset of the universe.
+
+#include "dancing_links.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/// Separators of the words of requests and model files.
+#define DLXD_SEPARATORS " \t\r\n"
+
+/// Maximal number of subsets required in solutions by a request.
+#define DLXD_MAX_REQUIRED 4096
+
+/// Model loaded in memory.
+struct dlxd_model
+{
+  char *name;
+  Universe universe;
+  unsigned long references;     ///< Number of requests running on the model, plus one while it is loaded.
+  struct dlxd_model *next;
+};
+
+/// Connections waiting for a worker.
+struct dlxd_queue
+{
+  int *connections;
+  unsigned long length;
+  unsigned long capacity;
+  int closed;
+  pthread_mutex_t mutex;
+  pthread_cond_t ready;
+};
+
+/// Connection served by a worker, and search running on it.
+struct dlxd_activity
+{
+  int connection;               ///< Connection (-1 if none.)
+  SearchContext context;        ///< Search context of the running search (0 if none.)
+};
+
+static struct dlxd_model *models = 0;
+static pthread_mutex_t models_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct dlxd_queue queue = { 0, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static volatile sig_atomic_t stopping = 0;
+static struct dlxd_activity *activities = 0;    ///< Activity of each worker.
+static pthread_mutex_t activities_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// Sets the connection served by a worker.
+/// @param [in] activity Activity of the worker
+/// @param [in] connection Connection (-1 if none.)
+///
+/// When the daemon is stopping, the connection is shut down for reading at once, so that reading requests from it does not block.
+static void
+dlxd_connection_set (struct dlxd_activity *activity, int connection)
+{
+  pthread_mutex_lock (&activities_mutex);
+  activity->connection = connection;
+  if (stopping && connection >= 0)
+    shutdown (connection, SHUT_RD);
+  pthread_mutex_unlock (&activities_mutex);
+}
+
+/// Sets the search context of the search running on a worker.
+/// @param [in] activity Activity of the worker
+/// @param [in] context Search context (0 if none.)
+///
+/// When the daemon is stopping, the search is stopped at once.
+static void
+dlxd_context_set (struct dlxd_activity *activity, SearchContext context)
+{
+  pthread_mutex_lock (&activities_mutex);
+  activity->context = context;
+  if (stopping && context)
+    dlx_checkpoint_request (context, 1);
+  pthread_mutex_unlock (&activities_mutex);
+}
+
+/// Releases a reference to a model, and the model with the last one.
+static void
+dlxd_model_release (struct dlxd_model *model)
+{
+  pthread_mutex_lock (&models_mutex);
+  unsigned long references = --model->references;
+
+  pthread_mutex_unlock (&models_mutex);
+
+  if (!references)
+  {
+    dlx_universe_destroy (model->universe);
+    free (model->name);
+    free (model);
+  }
+}
+
+/// Gets a reference to a loaded model.
+/// @return Model, or 0 if unknown. The reference must be released by dlxd_model_release().
+static struct dlxd_model *
+dlxd_model_get (const char *name)
+{
+  pthread_mutex_lock (&models_mutex);
+  struct dlxd_model *model;
+
+  for (model = models; model && strcmp (model->name, name); model = model->next)
+    /**/;
+  if (model)
+    model->references++;
+  pthread_mutex_unlock (&models_mutex);
+
+  return model;
+}
+
+/// Removes a model from the loaded models.
+/// @return 1 if the model was loaded, 0 otherwise.
+static int
+dlxd_model_unload (const char *name)
+{
+  pthread_mutex_lock (&models_mutex);
+  struct dlxd_model **link;
+
+  for (link = &models; *link && strcmp ((*link)->name, name); link = &(*link)->next)
+    /**/;
+
+  struct dlxd_model *model = *link;
+
+  if (model)
+    *link = model->next;
+  pthread_mutex_unlock (&models_mutex);
+
+  // The model is released once the requests running on it are completed.
+  if (model)
+    dlxd_model_release (model);
+
+  return model != 0;
+}
+
+/// Adds a model to the loaded models, in place of the model with the same name.
+///
+/// The replacement is atomic: concurrent loads of the same name leave a single model of that name.
+static void
+dlxd_model_add (const char *name, Universe universe)
+{
+  struct dlxd_model *model = malloc (sizeof (*model));
+
+  dlx_trace_set (universe, 0);
+  model->name = strdup (name);
+  model->universe = universe;
+  model->references = 1;
+
+  pthread_mutex_lock (&models_mutex);
+  struct dlxd_model **link;
+
+  for (link = &models; *link && strcmp ((*link)->name, name); link = &(*link)->next)
+    /**/;
+
+  struct dlxd_model *replaced = *link;
+
+  if (replaced)
+    *link = replaced->next;
+  model->next = models;
+  models = model;
+  pthread_mutex_unlock (&models_mutex);
+
+  // The replaced model is released once the requests running on it are completed.
+  if (replaced)
+    dlxd_model_release (replaced);
+}
+
+/// Lists the loaded models to a client.
+///
+/// The names are copied first, so that a slow client does not hold the other requests.
+static void
+dlxd_models_write (FILE *out)
+{
+  char **names = 0;
+  unsigned long nb_names = 0;
+
+  pthread_mutex_lock (&models_mutex);
+  for (struct dlxd_model * model = models; model; model = model->next)
+  {
+    names = realloc (names, (nb_names + 1) * sizeof (*names));
+    names[nb_names++] = strdup (model->name);
+  }
+  pthread_mutex_unlock (&models_mutex);
+
+  for (unsigned long i = 0; i < nb_names; i++)
+  {
+    fprintf (out, "model %s\n", names[i]);
+    free (names[i]);
+  }
+  free (names);
+  fprintf (out, "ok\n");
+}
+
+/// Loads a model from a file.
+/// @return Universe, or 0 if the file can not be read.
+static Universe
+dlxd_model_read (const char *filename, unsigned long *line_number)
+{
+  FILE *file = fopen (filename, "r");
+
+  *line_number = 0;
+  if (!file)
+    return 0;
+
+  Universe universe = 0;
+  char *line = 0;
+  size_t size = 0;
+  int ok = 1;
+
+  while (ok && getline (&line, &size, file) >= 0)
+  {
+    char *saveptr;
+    char *keyword = strtok_r (line, DLXD_SEPARATORS, &saveptr);
+
+    ++*line_number;
+    if (!keyword || *keyword == '#')
+      continue;
+
+    if (!strcmp (keyword, "elements") && !universe)
+      ok = (universe = dlx_universe_create (saveptr, DLXD_SEPARATORS)) != 0;
+    else if (!strcmp (keyword, "merge"))
+    {
+      if (!universe)
+        universe = dlx_universe_create ();
+      dlx_duplicates_merge_set (universe, 1);
+    }
+    else if (!strcmp (keyword, "subset"))
+    {
+      char *name = strtok_r (0, DLXD_SEPARATORS, &saveptr);
+
+      if (!universe)
+        universe = dlx_universe_create ();
+      ok = name && dlx_subset_define (universe, name, saveptr, DLXD_SEPARATORS);
+    }
+    else
+      ok = 0;
+  }
+
+  free (line);
+  fclose (file);
+
+  if (!ok || !universe)
+  {
+    dlx_universe_destroy (universe);
+    return 0;
+  }
+
+  return universe;
+}
+
+/// Settings and results of a search request.
+struct dlxd_search
+{
+  FILE *out;
+  unsigned long nodes;          ///< Budget of nodes (0 if none.)
+  unsigned long milliseconds;   ///< Budget of time (0 if none.)
+};
+
+/// Writes a solution to the client.
+static void
+dlxd_solution_write (Universe universe, unsigned long length, const char *const *solution, void *data)
+{
+  (void) universe;
+  struct dlxd_search *search = data;
+
+  if (!length && !solution)     // No solution found.
+    return;
+
+  fprintf (search->out, "solution");
+  for (unsigned long i = 0; i < length; i++)
+    fprintf (search->out, " %s", solution[i]);
+  fprintf (search->out, "\n");
+}
+
+/// Stops a search at the first report: reports are due when the budget of nodes or time is exhausted.
+static void
+dlxd_budget_exhausted (SearchContext context, const struct dlx_search_progress *progress, void *data)
+{
+  (void) progress;
+  (void) data;
+  dlx_checkpoint_request (context, 1);
+}
+
+/// Runs a search request.
+/// @param [in] activity Activity of the worker
+/// @param [in] command "count", "first" or "search".
+/// @param [in] name Name of the model.
+/// @param [in] saveptr Rest of the request: options.
+static void
+dlxd_search (struct dlxd_activity *activity, FILE *out, const char *command, const char *name, char *saveptr)
+{
+  struct dlxd_model *model = name ? dlxd_model_get (name) : 0;
+
+  if (!model)
+  {
+    fprintf (out, "error unknown model %s\n", name ? name : "");
+    return;
+  }
+
+  struct dlxd_search search = { out, 0, 0 };
+  const char *required[DLXD_MAX_REQUIRED];
+  unsigned long nb_required = 0;
+  enum dlx_engine engine = DLX_ENGINE_LINKS;
+  int propagation = 0;
+  const char *option;
+
+  while ((option = strtok_r (0, DLXD_SEPARATORS, &saveptr)))
+  {
+    if (!strncmp (option, "nodes=", 6))
+      search.nodes = strtoul (option + 6, 0, 10);
+    else if (!strncmp (option, "ms=", 3))
+      search.milliseconds = strtoul (option + 3, 0, 10);
+    else if (!strncmp (option, "require=", 8) && nb_required < DLXD_MAX_REQUIRED)
+      required[nb_required++] = option + 8;
+    else if (!strcmp (option, "engine=links") || !strcmp (option, "engine=cells") || !strcmp (option, "engine=auto"))
+      engine = option[7] == 'l' ? DLX_ENGINE_LINKS : option[7] == 'c' ? DLX_ENGINE_CELLS : DLX_ENGINE_AUTO;
+    else if (!strcmp (option, "propagation"))
+      propagation = 1;
+    else
+    {
+      fprintf (out, "error unknown option %s\n", option);
+      dlxd_model_release (model);
+      return;
+    }
+  }
+
+  // Subsets are required in solutions on a clone of the model, which is shared by the other requests.
+  Universe clone = 0;
+
+  if (nb_required)
+  {
+    clone = dlx_universe_clone (model->universe);
+    for (unsigned long i = 0; i < nb_required; i++)
+      if (!dlx_subset_require_in_solution (clone, required[i]))
+      {
+        fprintf (out, "error can not require %s\n", required[i]);
+        dlx_universe_destroy (clone);
+        dlxd_model_release (model);
+        return;
+      }
+  }
+
+  SearchContext context = dlx_search_context_create (clone ? clone : model->universe);
+
+  dlx_trace_set (context, 0);
+  dlx_engine_set (context, engine);
+  dlx_propagation_set (context, propagation);
+  if (strcmp (command, "count"))
+    dlx_displayer_set (context, dlxd_solution_write, &search);
+  if (search.nodes || search.milliseconds)
+    dlx_progress_set (context, dlxd_budget_exhausted, 0, search.nodes, search.milliseconds);
+
+  dlxd_context_set (activity, context);
+  unsigned long nb_solutions = dlx_exact_cover_search (context, !strcmp (command, "first"));
+
+  dlxd_context_set (activity, 0);
+  fprintf (out, "ok solutions %lu total %lu nodes %lu interrupted %i\n", nb_solutions, dlx_solutions_total (context), dlx_search_nodes (context),
+           dlx_search_interrupted (context));
+
+  dlx_search_context_destroy (context);
+  dlx_universe_destroy (clone);
+  dlxd_model_release (model);
+}
+
+/// Serves the requests of a connection, until it is closed.
+static void
+dlxd_serve (struct dlxd_activity *activity, int connection)
+{
+  FILE *in = fdopen (connection, "r");
+  FILE *out = fdopen (dup (connection), "w");
+  char *line = 0;
+  size_t size = 0;
+
+  dlxd_connection_set (activity, connection);
+
+  while (in && out && !stopping && getline (&line, &size, in) >= 0)
+  {
+    char *saveptr;
+    const char *command = strtok_r (line, DLXD_SEPARATORS, &saveptr);
+    const char *name = command ? strtok_r (0, DLXD_SEPARATORS, &saveptr) : 0;
+
+    if (!command)
+      continue;
+    else if (!strcmp (command, "quit"))
+      break;
+    else if (!strcmp (command, "count") || !strcmp (command, "first") || !strcmp (command, "search"))
+      dlxd_search (activity, out, command, name, saveptr);
+    else if (!strcmp (command, "load") && name)
+    {
+      const char *filename = strtok_r (0, DLXD_SEPARATORS, &saveptr);
+      unsigned long line_number = 0;
+      Universe universe = filename ? dlxd_model_read (filename, &line_number) : 0;
+
+      if (universe)
+      {
+        dlxd_model_add (name, universe);
+        fprintf (out, "ok\n");
+      }
+      else
+        fprintf (out, "error can not load %s (line %lu)\n", filename ? filename : "", line_number);
+    }
+    else if ((!strcmp (command, "sudoku") || !strcmp (command, "queens")) && name)
+    {
+      const char *size_argument = strtok_r (0, DLXD_SEPARATORS, &saveptr);
+      unsigned long n = size_argument ? strtoul (size_argument, 0, 10) : 0;
+      Universe universe = !strcmp (command, "sudoku") ? dlx_sudoku_create (n, 0, 0) : dlx_queens_create (n);
+
+      if (universe)
+      {
+        dlxd_model_add (name, universe);
+        fprintf (out, "ok\n");
+      }
+      else
+        fprintf (out, "error invalid size\n");
+    }
+    else if (!strcmp (command, "unload") && name)
+      fprintf (out, dlxd_model_unload (name) ? "ok\n" : "error unknown model %s\n", name);
+    else if (!strcmp (command, "models"))
+      dlxd_models_write (out);
+    else
+      fprintf (out, "error unknown request %s\n", command);
+
+    fflush (out);
+  }
+
+  dlxd_connection_set (activity, -1);
+  free (line);
+  if (out)
+    fclose (out);
+  if (in)
+    fclose (in);
+  else
+    close (connection);
+}
+
+/// Worker: serves the connections of the queue.
+/// @param [in] arg Activity of the worker
+static void *
+dlxd_worker (void *arg)
+{
+  struct dlxd_activity *activity = arg;
+
+  for (;;)
+  {
+    pthread_mutex_lock (&queue.mutex);
+    while (!queue.length && !queue.closed)
+      pthread_cond_wait (&queue.ready, &queue.mutex);
+    if (!queue.length)
+    {
+      pthread_mutex_unlock (&queue.mutex);
+      return 0;
+    }
+
+    int connection = queue.connections[0];
+
+    memmove (queue.connections, queue.connections + 1, --queue.length * sizeof (*queue.connections));
+    pthread_mutex_unlock (&queue.mutex);
+
+    dlxd_serve (activity, connection);
+  }
+}
+
+static void
+dlxd_stop (int signum)
+{
+  (void) signum;
+  stopping = 1;
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc < 2 || argc > 3)
+  {
+    fprintf (stderr, "Usage: %s socket [workers]\n", argv[0]);
+    return 2;
+  }
+
+  long nb_workers = argc > 2 ? strtol (argv[2], 0, 10) : sysconf (_SC_NPROCESSORS_ONLN);
+  struct sockaddr_un address;
+
+  if (nb_workers < 1)
+    nb_workers = 1;
+
+  memset (&address, 0, sizeof (address));
+  address.sun_family = AF_UNIX;
+  if (strlen (argv[1]) >= sizeof (address.sun_path))
+  {
+    fprintf (stderr, "%s: socket path too long.\n", argv[0]);
+    return 2;
+  }
+  strcpy (address.sun_path, argv[1]);
+
+  // The socket is reachable by the owner of the daemon only.
+  int listener = socket (AF_UNIX, SOCK_STREAM, 0);
+  mode_t mask = umask (0077);
+
+  unlink (argv[1]);
+  if (listener < 0 || bind (listener, (struct sockaddr *) &address, sizeof (address)) || listen (listener, 64))
+  {
+    perror (argv[1]);
+    return 1;
+  }
+  umask (mask);
+
+  // Signals stop the daemon (accept is interrupted), and clients closing their connection early do not.
+  struct sigaction action;
+
+  memset (&action, 0, sizeof (action));
+  action.sa_handler = dlxd_stop;
+  sigaction (SIGINT, &action, 0);
+  sigaction (SIGTERM, &action, 0);
+  signal (SIGPIPE, SIG_IGN);
+
+  // Signals are only handled by the main thread: workers block them, so that they always interrupt accept.
+  sigset_t signals;
+
+  sigemptyset (&signals);
+  sigaddset (&signals, SIGINT);
+  sigaddset (&signals, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signals, 0);
+
+  pthread_t workers[nb_workers];
+
+  activities = malloc (nb_workers * sizeof (*activities));
+  for (long w = 0; w < nb_workers; w++)
+  {
+    activities[w].connection = -1;
+    activities[w].context = 0;
+    pthread_create (&workers[w], 0, dlxd_worker, &activities[w]);
+  }
+  pthread_sigmask (SIG_UNBLOCK, &signals, 0);
+
+  while (!stopping)
+  {
+    int connection = accept (listener, 0, 0);
+
+    if (connection < 0)
+    {
+      if (errno != EINTR)
+        perror ("accept");
+      continue;
+    }
+
+    pthread_mutex_lock (&queue.mutex);
+    if (queue.length == queue.capacity)
+    {
+      queue.capacity = queue.capacity ? 2 * queue.capacity : 16;
+      queue.connections = realloc (queue.connections, queue.capacity * sizeof (*queue.connections));
+    }
+    queue.connections[queue.length++] = connection;
+    pthread_cond_signal (&queue.ready);
+    pthread_mutex_unlock (&queue.mutex);
+  }
+
+  close (listener);
+  unlink (argv[1]);
+
+  // Open connections are shut down for reading, so that workers waiting for requests are released, and running searches are stopped
+  // (they still answer.)
+  // Connections still waiting for a worker are closed without being served.
+  pthread_mutex_lock (&activities_mutex);
+  for (long w = 0; w < nb_workers; w++)
+  {
+    if (activities[w].connection >= 0)
+      shutdown (activities[w].connection, SHUT_RD);
+    if (activities[w].context)
+      dlx_checkpoint_request (activities[w].context, 1);
+  }
+  pthread_mutex_unlock (&activities_mutex);
+
+  pthread_mutex_lock (&queue.mutex);
+  queue.closed = 1;
+  pthread_cond_broadcast (&queue.ready);
+  pthread_mutex_unlock (&queue.mutex);
+  for (long w = 0; w < nb_workers; w++)
+    pthread_join (workers[w], 0);
+  free (queue.connections);
+  free (activities);
+
+  while (models)
+    dlxd_model_unload (models->name);
+
+  return 0;
+}
@@ -1,140 +1,354 @@
 #undef NDEBUG
 #include "dancing_links.h"
 #include <assert.h>
+#include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
-static void
-test_sudoku (void)
+struct search_thread_data
 {
-  //Test 1
-  // Sudoku solver
-  char cell[] = "R?C?#?";
-  char inCell[] = "R?C?";
-  char inRow[] = "R?#?";
-  char inColumn[] = "C?#?";
-  char inBox[] = "B?#?";
+  SearchContext context;
+  int one_only;
+  unsigned long nb_solutions;
+};
 
-  Universe sudoku = dlx_universe_create ();
+static void *
+search_thread (void *arg)
+{
+  struct search_thread_data *data = arg;
 
-  char line[strlen (inCell) + 1 + strlen (inRow) + 1 + strlen (inColumn) + 1 + strlen (inBox) + 1];
+  data->nb_solutions = dlx_exact_cover_search (data->context, data->one_only);
+  return 0;
+}
 
-  // 729 lines
-  for (int row = 1; row <= 9; row++)
-    for (int column = 1; column <= 9; column++)
-      for (int number = 1; number <= 9; number++)
-      {
-        cell[1] = '0' + row;
-        cell[3] = '0' + column;
-        cell[5] = '0' + number;
-
-        *line = 0;
-        inCell[1] = '0' + row;
-        inCell[3] = '0' + column;
-        strcat (line, inCell);
-        strcat (line, "|");
-
-        inRow[1] = '0' + row;
-        inRow[3] = '0' + number;
-        strcat (line, inRow);
-        strcat (line, "|");
-
-        inColumn[1] = '0' + column;
-        inColumn[3] = '0' + number;
-        strcat (line, inColumn);
-        strcat (line, "|");
-
-        inBox[1] = '0' + 3 * ((row - 1) / 3) + (column - 1) / 3 + 1;
-        inBox[3] = '0' + number;
-        strcat (line, inBox);
-
-        dlx_subset_define (sudoku, cell, line, "|");
-      }
+struct stop_data
+{
+  SearchContext context;
+  unsigned long nb_solutions;
+  unsigned long stop_after;
+};
 
-  // Initial grid
-  dlx_subset_require_in_solution (sudoku, "R1C4#8");
-  dlx_subset_require_in_solution (sudoku, "R1C6#1");
-  dlx_subset_require_in_solution (sudoku, "R2C8#4");
-  dlx_subset_require_in_solution (sudoku, "R2C9#3");
-  dlx_subset_require_in_solution (sudoku, "R3C1#5");
-  dlx_subset_require_in_solution (sudoku, "R4C5#7");
-  dlx_subset_require_in_solution (sudoku, "R4C7#8");
-  dlx_subset_require_in_solution (sudoku, "R5C7#1");
-  dlx_subset_require_in_solution (sudoku, "R6C2#2");
-  dlx_subset_require_in_solution (sudoku, "R6C5#3");
-  dlx_subset_require_in_solution (sudoku, "R7C1#6");
-  dlx_subset_require_in_solution (sudoku, "R7C8#7");
-  dlx_subset_require_in_solution (sudoku, "R7C9#5");
-  dlx_subset_require_in_solution (sudoku, "R8C3#3");
-  dlx_subset_require_in_solution (sudoku, "R8C4#4");
-  dlx_subset_require_in_solution (sudoku, "R9C4#2");
-  dlx_subset_require_in_solution (sudoku, "R9C7#6");
-
-  printf ("%lu solution(s) found.\n", dlx_exact_cover_search (sudoku, 0));
+static void
+stop_after_solutions (Universe universe, unsigned long length, const char *const *solution, void *ptr)
+{
+  (void) universe;
+  (void) solution;
+  struct stop_data *data = ptr;
 
-  dlx_universe_destroy (sudoku);
+  if (length && ++data->nb_solutions == data->stop_after)
+    dlx_checkpoint_request (data->context, 1);  // As would a handler of SIGTERM.
 }
 
-struct cell
+static int
+count_bytes (const void *bytes, unsigned long size, void *data)
 {
-  char *name;
-  struct
-  {
-    int x, y;
-  } coord;
+  (void) bytes;
+  *(unsigned long *) data += size;
+  return 1;
+}
+
+struct event_data
+{
+  unsigned long path[8];
+  unsigned long depth;
+  unsigned long nb_solutions;
+  unsigned long frequency[8];
 };
 
-struct pentomino
+static void
+check_events (SearchContext context, enum dlx_search_event event, unsigned long depth, unsigned long subset, const char *name, void *ptr)
 {
-  char *name;
-  struct
+  (void) context;
+  (void) name;
+  struct event_data *data = ptr;
+
+  switch (event)
   {
-    int x, y;
-  } tile[5];
-  int rotation;
-  int chirality;
+    case DLX_EVENT_PUSH:
+      assert (depth == data->depth);
+      data->path[data->depth++] = subset;
+      break;
+    case DLX_EVENT_POP:
+      assert (depth == --data->depth && data->path[depth] == subset);
+      break;
+    case DLX_EVENT_SOLUTION:
+      assert (depth == data->depth);
+      data->nb_solutions++;
+      for (unsigned long k = 0; k < depth; k++)
+        data->frequency[data->path[k]]++;
+      break;
+  }
+}
+
+/// Checks that the queens of a solution of the N-queens problem do not attack each other.
+static void
+check_queens (Universe universe, unsigned long length, const char *const *solution, void *ptr)
+{
+  unsigned long *columns = ptr;
+
+  assert (length == 8 && dlx_queens_decode (universe, 8, length, solution, columns));
+  for (unsigned long i = 0; i < 8; i++)
+    for (unsigned long j = 0; j < i; j++)
+      assert (columns[i] != columns[j] && columns[i] + j != columns[j] + i && columns[i] + i != columns[j] + j);
+}
+
+/// Keeps the name of the first subset of a solution.
+static void
+keep_first_subset (Universe universe, unsigned long length, const char *const *solution, void *ptr)
+{
+  (void) universe;
+  if (length)
+    *(const char **) ptr = solution[0];
+}
+
+/// Counts the solutions of the 6-queens problem drawn at random, by column of their first queen.
+static void
+count_first_queens (Universe universe, unsigned long length, const char *const *solution, void *ptr)
+{
+  unsigned long *counts = ptr;
+  unsigned long columns[6];
+
+  assert (length == 6 && dlx_queens_decode (universe, 6, length, solution, columns));
+  counts[columns[0]]++;
+}
+
+/// Searches a universe with both search engines, which must find as many solutions in as many nodes.
+static unsigned long
+search_with_both_engines (Universe universe)
+{
+  SearchContext links = dlx_search_context_create (universe);
+  SearchContext cells = dlx_search_context_create (universe);
+
+  dlx_engine_set (cells, DLX_ENGINE_CELLS);
+  unsigned long nb_solutions = dlx_exact_cover_search (links, 0);
+
+  assert (dlx_exact_cover_search (cells, 0) == nb_solutions);
+  assert (dlx_search_nodes (cells) == dlx_search_nodes (links));
+  dlx_search_context_destroy (links);
+  dlx_search_context_destroy (cells);
+
+  return nb_solutions;
+}
+
+struct progress_data
+{
+  unsigned long nb_reports;
+  double fraction;
 };
 
-struct candidate
+static void
+check_progress (SearchContext context, const struct dlx_search_progress *progress, void *ptr)
 {
-  char *name;
-  char *pentomino_name;
-  struct
-  {
-    char *cell_name;
-  } tile[5];
+  (void) context;
+  struct progress_data *data = ptr;
+
+  assert (progress->fraction >= data->fraction && progress->fraction < 1);      // The explored fraction increases.
+  for (unsigned long level = 0; level < progress->levels; level++)
+    assert (progress->position[level] < progress->branches[level]);
+  data->fraction = progress->fraction;
+  data->nb_reports++;
+}
+
+struct sudoku_data
+{
+  unsigned long n;
+  unsigned long nb_regions;
+  const unsigned long *regions;
+  unsigned long nb_solutions;
 };
 
-struct callback_data
+/// Checks that the grid of a solution of a sudoku holds every digit once in every row, column, box and extra region.
+static void
+check_sudoku (Universe universe, unsigned long length, const char *const *solution, void *ptr)
+{
+  struct sudoku_data *data = ptr;
+  unsigned long n = data->n;
+  unsigned long size = n * n;
+  unsigned long grid[size * size];
+
+  assert (dlx_sudoku_decode (universe, n, length, solution, grid));
+  for (unsigned long i = 0; i < size * size; i++)
+    assert (grid[i] >= 1 && grid[i] <= size);
+  for (unsigned long i = 0; i < size; i++)
+    for (unsigned long j = 0; j < size; j++)
+      for (unsigned long k = 0; k < j; k++)
+      {
+        assert (grid[i * size + j] != grid[i * size + k]);
+        assert (grid[j * size + i] != grid[k * size + i]);
+        assert (grid[((i / n) * n + j / n) * size + (i % n) * n + j % n] != grid[((i / n) * n + k / n) * size + (i % n) * n + k % n]);
+      }
+  for (unsigned long r = 0; r < data->nb_regions; r++)
+    for (unsigned long j = 0; j < size; j++)
+      for (unsigned long k = 0; k < j; k++)
+        assert (grid[data->regions[r * size + j]] != grid[data->regions[r * size + k]]);
+  data->nb_solutions++;
+}
+
+static void
+test_sudoku (void)
+{
+  //Test 1
+  // Sudoku solver: 729 subsets "R?C?#?", each covering a cell, a digit in a row, a digit in a column and a digit in a box.
+  Universe sudoku = dlx_sudoku_create (3, 0, 0);
+
+  // The base universe (empty grid) is cloned for the grid to be solved.
+  Universe grid = dlx_universe_clone (sudoku);
+
+  // Initial grid
+  dlx_subset_require_in_solution (grid, "R1C4#8");
+  dlx_subset_require_in_solution (grid, "R1C6#1");
+  dlx_subset_require_in_solution (grid, "R2C8#4");
+  dlx_subset_require_in_solution (grid, "R2C9#3");
+  dlx_subset_require_in_solution (grid, "R3C1#5");
+  dlx_subset_require_in_solution (grid, "R4C5#7");
+  dlx_subset_require_in_solution (grid, "R4C7#8");
+  dlx_subset_require_in_solution (grid, "R5C7#1");
+  dlx_subset_require_in_solution (grid, "R6C2#2");
+  dlx_subset_require_in_solution (grid, "R6C5#3");
+  dlx_subset_require_in_solution (grid, "R7C1#6");
+  dlx_subset_require_in_solution (grid, "R7C8#7");
+  dlx_subset_require_in_solution (grid, "R7C9#5");
+  dlx_subset_require_in_solution (grid, "R8C3#3");
+  dlx_subset_require_in_solution (grid, "R8C4#4");
+  dlx_subset_require_in_solution (grid, "R9C4#2");
+  dlx_subset_require_in_solution (grid, "R9C7#6");
+
+  // The base universe is left unchanged by its clone, which keeps valid once the base universe is released.
+  dlx_trace_set (sudoku, 0);
+  assert (dlx_exact_cover_search (sudoku, 1) == 1);
+  dlx_universe_destroy (sudoku);
+
+  printf ("%lu solution(s) found.\n", dlx_exact_cover_search (grid, 0));
+
+  // The solution is mapped back to a grid.
+  struct sudoku_data solved = { 3, 0, 0, 0 };
+  SearchContext context = dlx_search_context_create (grid);
+
+  dlx_displayer_set (context, check_sudoku, &solved);
+  assert (dlx_exact_cover_search (context, 0) == 1 && solved.nb_solutions == 1);
+  dlx_search_context_destroy (context);
+
+  // Concurrent searches on the same universe, each on its own search context.
+  pthread_t threads[4];
+  struct search_thread_data data[sizeof (threads) / sizeof (*threads)];
+
+  for (size_t i = 0; i < sizeof (threads) / sizeof (*threads); i++)
+  {
+    data[i].context = dlx_search_context_create (grid);
+    dlx_trace_set (data[i].context, 0);
+    dlx_displayer_set (data[i].context, 0, 0);
+    data[i].one_only = i % 2;
+    pthread_create (&threads[i], 0, search_thread, &data[i]);
+  }
+
+  for (size_t i = 0; i < sizeof (threads) / sizeof (*threads); i++)
+  {
+    pthread_join (threads[i], 0);
+    assert (data[i].nb_solutions == 1);
+    dlx_search_context_destroy (data[i].context);
+  }
+
+  // With propagation, forced subsets are not nodes of the search.
+  context = dlx_search_context_create (grid);
+
+  dlx_trace_set (context, 0);
+  dlx_displayer_set (context, 0, 0);
+  assert (dlx_exact_cover_search (context, 0) == 1);
+  unsigned long nb_nodes = dlx_search_nodes (context);
+  assert (!dlx_propagation_set (context, 1));
+  assert (dlx_exact_cover_search (context, 0) == 1);
+  assert (dlx_search_nodes (context) < nb_nodes && dlx_propagation_forced (context) > 0);
+  printf ("%lu nodes (%lu with propagation, %lu forced subsets, %lu dead ends).\n", nb_nodes, dlx_search_nodes (context),
+          dlx_propagation_forced (context), dlx_propagation_dead_ends (context));
+  dlx_search_context_destroy (context);
+
+  // The dancing cells search engine visits as many nodes as the dancing links one.
+  context = dlx_search_context_create (grid);
+  dlx_trace_set (context, 0);
+  dlx_displayer_set (context, 0, 0);
+  assert (dlx_engine_set (context, DLX_ENGINE_CELLS) == DLX_ENGINE_LINKS);
+  assert (dlx_exact_cover_search (context, 0) == 1);
+  assert (dlx_search_nodes (context) == nb_nodes);
+
+  // Automatic selection: 256 cells, rows, columns and boxes to be covered, and a calibration which explores the whole search tree.
+  assert (dlx_engine_set (context, DLX_ENGINE_AUTO) == DLX_ENGINE_CELLS);
+  assert (!dlx_auto_choice (context));
+  dlx_auto_calibration_set (context, 100000);
+  dlx_propagation_set (context, 1);
+  assert (dlx_exact_cover_search (context, 0) == 1);
+  const struct dlx_auto_choice *choice = dlx_auto_choice (context);
+
+  assert (choice && choice->nb_elements == 4 * (81 - 17) && choice->mean_subset_length == 4 && choice->calibration_complete);
+  assert (choice->nb_workers == 1);
+  printf ("Automatic selection: %s engine%s.\n", choice->engine == DLX_ENGINE_CELLS ? "dancing cells" : "dancing links",
+          choice->propagation ? " with propagation" : "");
+
+  // The choice leaves the settings of the search context unchanged, and the calibration is not run again for the same model and settings.
+  double links_milliseconds = choice->links_milliseconds;
+
+  assert (dlx_exact_cover_search (context, 0) == 1 && dlx_auto_choice (context)->links_milliseconds == links_milliseconds);
+  assert (dlx_propagation_set (context, 0) == 1);
+
+  // Calibration runs on a scratch search context: progress is only reported by the search itself.
+  struct progress_data progress = { 0, 0 };
+
+  dlx_progress_set (context, check_progress, &progress, 10, 0);
+  assert (dlx_exact_cover_search (context, 0) == 1 && progress.nb_reports == dlx_search_nodes (context) / 10);
+  assert (dlx_auto_choice (context)->engine == DLX_ENGINE_LINKS);   // Progress reports need the links between elements.
+  assert (dlx_auto_choice (context)->subset_order == DLX_ORDER_DEFINITION);
+  assert (dlx_exact_cover_search (context, 1) == 1 && dlx_auto_choice (context)->subset_order == DLX_ORDER_LEAST_CONSTRAINING);
+  dlx_search_context_destroy (context);
+
+  dlx_universe_destroy (grid);
+
+  // 4×4 grids, then with their two diagonals as extra regions.
+  const unsigned long diagonals[] = { 0, 5, 10, 15, 3, 6, 9, 12 };
+  struct sudoku_data small = { 2, 0, 0, 0 };
+
+  grid = dlx_sudoku_create (2, 0, 0);
+  dlx_displayer_set (grid, check_sudoku, &small);
+  assert (dlx_exact_cover_search (grid, 0) == 288 && small.nb_solutions == 288);
+  dlx_universe_destroy (grid);
+
+  small.nb_regions = 2;
+  small.regions = diagonals;
+  small.nb_solutions = 0;
+  assert (!dlx_sudoku_create (2, 1, (const unsigned long[]) { 0, 1, 2, 16 }));  // Not a cell.
+  assert (!dlx_sudoku_create (2, 1, (const unsigned long[]) { 0, 1, 2, 1 }));   // Repeated cell.
+  grid = dlx_sudoku_create (2, small.nb_regions, small.regions);
+  dlx_displayer_set (grid, check_sudoku, &small);
+  unsigned long nb_solutions = dlx_exact_cover_search (grid, 0);
+
+  assert (nb_solutions > 0 && nb_solutions < 288 && small.nb_solutions == nb_solutions);
+  printf ("%lu 4x4 sudoku X grids.\n", nb_solutions);
+  dlx_universe_destroy (grid);
+}
+
+/// Packing of pieces on a board, built by dlx_polyomino_create().
+struct packing
 {
-  struct cell *grid;
-  int grid_size;
-  struct pentomino *pentominoes;
-  int nb_pentominoes;
-  struct candidate *candidates;
-  int nb_candidates;
+  unsigned long nb_cells;
+  const struct dlx_cell *board;
+  unsigned long nb_pieces;
+  const struct dlx_piece *pieces;
 };
 
 static void
 my_dlx_solution_for_pentomino (Universe universe, unsigned long length, const char *const *solution, void *ptr)
 {
-  (void) universe;
-  struct callback_data *data = ptr;
-
-  char *board[8][8];
+  struct packing *data = ptr;
+  unsigned long pieces[data->nb_cells];
+  const char *board[8][8];
 
   for (int i = 0; i < 8; i++)
     for (int j = 0; j < 8; j++)
       board[i][j] = 0;
 
-  for (unsigned long pento = 0; pento < length; pento++)
-    for (int candidate = 0; candidate < data->nb_candidates; candidate++)
-      if (!strcmp (solution[pento], data->candidates[candidate].name))
-        for (size_t tile = 0; tile < sizeof (data->candidates[candidate].tile) / sizeof (*data->candidates[candidate].tile); tile++)
-          for (int cell = 0; cell < data->grid_size; cell++)
-            if (!strcmp (data->candidates[candidate].tile[tile].cell_name, data->grid[cell].name))
-              board[data->grid[cell].coord.x][data->grid[cell].coord.y] = data->candidates[candidate].pentomino_name;
+  assert (dlx_polyomino_decode (universe, data->nb_pieces, length, solution, pieces));
+  for (unsigned long cell = 0; cell < data->nb_cells; cell++)
+    board[data->board[cell].x][data->board[cell].y] = data->pieces[pieces[cell]].name;
 
   printf ("\n");
   for (int i = 0; i < 8; i++)
@@ -166,10 +380,10 @@ my_dlx_solution_for_pentomino (Universe universe, unsigned long length, const ch
 /// - I can be oriented in 2 ways by rotation.
 ///   It has two axes of reflection symmetry, both aligned with the gridlines.
 ///   Its symmetry group has four elements, the identity, two reflections and the 180° rotation.
-///   It is the dihedral group of order 2, also known as the Klein four-group.
+///   It is the dihedral group of order 4, also known as the Klein four-group.
 /// - X can be oriented in only one way.
 ///   It has four axes of reflection symmetry, aligned with the gridlines and the diagonals, and rotational symmetry of order 4.
-///   Its symmetry group, the dihedral group of order 4, has eight elements.
+///   Its symmetry group, the dihedral group of order 8, has eight elements.
 ///
 /// The F, L, N, P, Y, and Z pentominoes are chiral; adding their reflections (F', J, N', Q, Y', S) brings the number of one-sided pentominoes to 18.
 /// If rotations are also considered distinct, then the pentominoes from the first category count eightfold, the ones from the next three categories (T, U, V, W, Z) count fourfold, I counts twice, and X counts only once. This results in 5×8 + 5×4 + 2 + 1 = 63 fixed pentominoes.
@@ -179,150 +393,150 @@ static void
 test_pentomino (void)
 {
 /* *INDENT-OFF* */
-  struct cell grid[] =
+  static const struct dlx_cell tiles[][5] =
   {
-    {"11", {0, 0}}, {"12", {0, 1}}, {"13", {0, 2}}, {"14", {0, 3}}, {"15", {0, 4}}, {"16", {0, 5}}, {"17", {0, 6}}, {"18", {0, 7}},
-    {"21", {1, 0}}, {"22", {1, 1}}, {"23", {1, 2}}, {"24", {1, 3}}, {"25", {1, 4}}, {"26", {1, 5}}, {"27", {1, 6}}, {"28", {1, 7}},
-    {"31", {2, 0}}, {"32", {2, 1}}, {"33", {2, 2}}, {"34", {2, 3}}, {"35", {2, 4}}, {"36", {2, 5}}, {"37", {2, 6}}, {"38", {2, 7}},
-    {"41", {3, 0}}, {"42", {3, 1}}, {"43", {3, 2}},                                 {"46", {3, 5}}, {"47", {3, 6}}, {"48", {3, 7}},
-    {"51", {4, 0}}, {"52", {4, 1}}, {"53", {4, 2}},                                 {"56", {4, 5}}, {"57", {4, 6}}, {"58", {4, 7}},
-    {"61", {5, 0}}, {"62", {5, 1}}, {"63", {5, 2}}, {"64", {5, 3}}, {"65", {5, 4}}, {"66", {5, 5}}, {"67", {5, 6}}, {"68", {5, 7}},
-    {"71", {6, 0}}, {"72", {6, 1}}, {"73", {6, 2}}, {"74", {6, 3}}, {"75", {6, 4}}, {"76", {6, 5}}, {"77", {6, 6}}, {"78", {6, 7}},
-    {"81", {7, 0}}, {"82", {7, 1}}, {"83", {7, 2}}, {"84", {7, 3}}, {"85", {7, 4}}, {"86", {7, 5}}, {"87", {7, 6}}, {"88", {7, 7}},
-  };
-
-  struct pentomino pentomino[] =
-  {
-    {"I", {{0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}}, 2, 0},  // I  11  12  13  14  15
-    {"N", {{0, 0}, {1, 0}, {1, 1}, {2, 1}, {3, 1}}, 4, 1},  // N  16  26  27  37  47, chiral
-    {"L", {{0, 0}, {0, 1}, {1, 1}, {2, 1}, {3, 1}}, 4, 1},  // L  17  18  28  38  48, chiral
-    {"U", {{0, 0}, {0, 1}, {1, 0}, {2, 0}, {2, 1}}, 4, 0},  // U  21  22  31  41  42
-    {"X", {{0, 0}, {1,-1}, {1, 0}, {1, 1}, {2, 0}}, 1, 0},  // X  23  32  33  34  43
-    {"W", {{0, 0}, {0, 1}, {1, 1}, {1, 2}, {2, 2}}, 4, 0},  // W  24  25  35  36  46
-    {"P", {{0, 0}, {0, 1}, {0, 2}, {1, 1}, {1, 2}}, 4, 1},  // P  51  52  53  62  63, chiral
-    {"F", {{0, 0}, {1,-2}, {1,-1}, {1, 0}, {2,-1}}, 4, 1},  // F  56  64  65  66  75, chiral
-    {"Z", {{0, 0}, {0, 1}, {1, 0}, {2,-1}, {2, 0}}, 2, 1},  // Z  57  58  67  76  77, chiral
-    {"T", {{0, 0}, {1, 0}, {1, 1}, {1, 2}, {2, 0}}, 4, 0},  // T  61  71  72  73  81
-    {"V", {{0, 0}, {1, 0}, {2,-2}, {2,-1}, {2, 0}}, 4, 0},  // V  68  78  86  87  88
-    {"Y", {{0, 0}, {1,-2}, {1,-1}, {1, 0}, {1, 1}}, /*4, 1*/ 1, 0 /* breaking symetry */},  // Y  74  82  83  84  85, chiral
+    {{0, 0, 0}, {0, 1, 0}, {0, 2, 0}, {0, 3, 0}, {0, 4, 0}},  // I
+    {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {2, 1, 0}, {3, 1, 0}},  // N, chiral
+    {{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {2, 1, 0}, {3, 1, 0}},  // L, chiral
+    {{0, 0, 0}, {0, 1, 0}, {1, 0, 0}, {2, 0, 0}, {2, 1, 0}},  // U
+    {{0, 0, 0}, {1,-1, 0}, {1, 0, 0}, {1, 1, 0}, {2, 0, 0}},  // X
+    {{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {1, 2, 0}, {2, 2, 0}},  // W
+    {{0, 0, 0}, {0, 1, 0}, {0, 2, 0}, {1, 1, 0}, {1, 2, 0}},  // P, chiral
+    {{0, 0, 0}, {1,-2, 0}, {1,-1, 0}, {1, 0, 0}, {2,-1, 0}},  // F, chiral
+    {{0, 0, 0}, {0, 1, 0}, {1, 0, 0}, {2,-1, 0}, {2, 0, 0}},  // Z, chiral
+    {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {1, 2, 0}, {2, 0, 0}},  // T
+    {{0, 0, 0}, {1, 0, 0}, {2,-2, 0}, {2,-1, 0}, {2, 0, 0}},  // V
+    {{0, 0, 0}, {1,-2, 0}, {1,-1, 0}, {1, 0, 0}, {1, 1, 0}},  // Y, chiral
   };
 /* *INDENT-ON* */
-
-  // Initialize universe
-  char *columns[sizeof (pentomino) / sizeof (*pentomino) + sizeof (grid) / sizeof (*grid)];
+  const char *names[] = { "I", "N", "L", "U", "X", "W", "P", "F", "Z", "T", "V", "Y" };
+  struct dlx_piece pentomino[sizeof (tiles) / sizeof (*tiles)];
 
   for (size_t pento = 0; pento < sizeof (pentomino) / sizeof (*pentomino); pento++)
-    columns[pento] = pentomino[pento].name;
-
-  for (size_t cell = 0; cell < sizeof (grid) / sizeof (*grid); cell++)
-    columns[sizeof (pentomino) / sizeof (*pentomino) + cell] = grid[cell].name;
-
-  Universe universe = dlx_universe_create (sizeof (columns) / sizeof (*columns), (const char **) columns);
-
-  // Initialize subsets
-  int nb_subsets = 0;
-  char *subset[1 + sizeof (pentomino[0].tile) / sizeof (*pentomino[0].tile)];
-  struct candidate *candidates = 0;
+  {
+    pentomino[pento].name = names[pento];
+    pentomino[pento].nb_cells = sizeof (*tiles) / sizeof (**tiles);
+    pentomino[pento].cells = tiles[pento];
+  }
 
-  int nb_fixed_pentominoes = 0;
+  // The 8×8 board without its 2×2 center.
+  struct dlx_cell grid[8 * 8 - 2 * 2];
+  unsigned long index[8][8];
+  unsigned long nb_cells = 0;
 
-  for (size_t pento = 0; pento < sizeof (pentomino) / sizeof (*pentomino); pento++)
-  {
-    subset[0] = pentomino[pento].name;
-    for (int chirality = 1; chirality >= -1; chirality -= 2)
-    {
-      for (int rotation = 0; rotation < pentomino[pento].rotation; rotation++)
+  for (long x = 0; x < 8; x++)
+    for (long y = 0; y < 8; y++)
+      if (x < 3 || x > 4 || y < 3 || y > 4)
       {
-        for (size_t cell = 0; cell < sizeof (grid) / sizeof (*grid); cell++)
-        {
-          int invalid_subset = 0;
-
-          for (size_t tile = 0; tile < sizeof (pentomino[pento].tile) / sizeof (*pentomino[pento].tile); tile++)
-          {
-            int I = grid[cell].coord.x;
-            int J = grid[cell].coord.y;
-
-            switch (rotation)
-            {
-              case 0:
-                I += pentomino[pento].tile[tile].x * chirality;
-                J += pentomino[pento].tile[tile].y;
-                break;
-              case 1:
-                I += pentomino[pento].tile[tile].y;
-                J -= pentomino[pento].tile[tile].x * chirality;
-                break;
-              case 2:
-                I -= pentomino[pento].tile[tile].x * chirality;
-                J -= pentomino[pento].tile[tile].y;
-                break;
-              case 3:
-                I -= pentomino[pento].tile[tile].y;
-                J += pentomino[pento].tile[tile].x * chirality;
-                break;
-            }
-
-            subset[1 + tile] = 0;
-            for (size_t other_cell = 0; other_cell < sizeof (grid) / sizeof (*grid); other_cell++)
-              if (grid[other_cell].coord.x == I && grid[other_cell].coord.y == J)
-              {
-                subset[1 + tile] = grid[other_cell].name;
-                break;
-              }
-
-            if (subset[1 + tile] == 0)
-            {
-              invalid_subset = 1;
-              break;
-            }
-          }                     // for tile
-
-          if (!invalid_subset)
-          {
-            char subset_name[10];
-
-            snprintf (subset_name, sizeof (subset_name) / sizeof (*subset_name), "%9i", nb_subsets);
-            dlx_subset_define (universe, subset_name, sizeof (subset) / sizeof (*subset), (const char **) subset);
-
-            struct candidate candidate;
-
-            candidate.name = strdup (subset_name);
-            candidate.pentomino_name = subset[0];
-            for (size_t tile = 0; tile < sizeof (pentomino[pento].tile) / sizeof (*pentomino[pento].tile); tile++)
-              candidate.tile[tile].cell_name = subset[1 + tile];
-
-            nb_subsets++;
-
-            candidates = realloc (candidates, nb_subsets * sizeof (*candidates));
-            candidates[nb_subsets - 1] = candidate;
-          }
-        }                       // for cell
-        nb_fixed_pentominoes++;
-      }                         // for rotation
-
-      if (!pentomino[pento].chirality)
-        break;
-    }                           // for chirality
-  }                             // for pento
-  fprintf (stderr, "%i fixed pentominoes.\n", nb_fixed_pentominoes);
-  fprintf (stderr, "%i subsets defined.\n", nb_subsets);
-
-  struct callback_data data;
-
-  data.candidates = candidates;
-  data.nb_candidates = nb_subsets;
-  data.pentominoes = pentomino;
-  data.nb_pentominoes = sizeof (pentomino) / sizeof (*pentomino);
-  data.grid = grid;
-  data.grid_size = sizeof (grid) / sizeof (*grid);
+        index[x][y] = nb_cells;
+        grid[nb_cells++] = (struct dlx_cell) { x, y, 0 };
+      }
+
+  // Pentominoes can be rotated and reflected: the 63 fixed pentominoes are generated.
+  struct packing data = { nb_cells, grid, sizeof (pentomino) / sizeof (*pentomino), pentomino };
+  Universe universe = dlx_polyomino_create (data.nb_cells, data.board, data.nb_pieces, data.pieces, 2, 1);
 
   dlx_displayer_set (universe, my_dlx_solution_for_pentomino, &data);
 
-  printf ("%lu solution(s) found.\n", dlx_exact_cover_search (universe, 0));
+  // Symmetries of the board: rotation by 90° and reflection (they generate the dihedral group of order 8.)
+  // Pieces are left unchanged, and cells of the board are indexed after them.
+  unsigned long rotated[data.nb_pieces + data.nb_cells];
+  unsigned long reflected[data.nb_pieces + data.nb_cells];
 
-  for (int c = 0; c < data.nb_candidates; c++)
-    free (data.candidates[c].name);
-  free (data.candidates);
+  for (unsigned long pento = 0; pento < data.nb_pieces; pento++)
+    rotated[pento] = reflected[pento] = pento;
+  for (unsigned long cell = 0; cell < data.nb_cells; cell++)
+  {
+    rotated[data.nb_pieces + cell] = data.nb_pieces + index[grid[cell].y][7 - grid[cell].x];
+    reflected[data.nb_pieces + cell] = data.nb_pieces + index[grid[cell].x][7 - grid[cell].y];
+  }
+
+  assert (dlx_symmetry_define (universe, sizeof (rotated) / sizeof (*rotated), rotated));
+  assert (dlx_symmetry_define (universe, sizeof (reflected) / sizeof (*reflected), reflected));
+
+  unsigned long nb_solutions = dlx_exact_cover_search (universe, 0);
+
+  printf ("%lu solution(s) found (%lu with symmetric images).\n", nb_solutions, dlx_solutions_total (universe));
+  assert (nb_solutions == 65);
+  assert (dlx_solutions_total (universe) == 8 * 65);
+
+  // Checkpoint / resume: the search is stopped after 20 solutions, and resumed by another search context (with propagation.)
+  const char *checkpoint = "pentomino.checkpoint";
+  struct stop_data stop = { dlx_search_context_create (universe), 0, 20 };
+
+  dlx_propagation_set (stop.context, 1);
+  dlx_displayer_set (stop.context, stop_after_solutions, &stop);
+  dlx_checkpoint_set (stop.context, checkpoint, 100000);
+  assert (dlx_exact_cover_search (stop.context, 0) == 20);
+  assert (dlx_search_interrupted (stop.context));
+  dlx_search_context_destroy (stop.context);
+
+  stop.context = dlx_search_context_create (universe);
+  dlx_propagation_set (stop.context, 1);
+  dlx_displayer_set (stop.context, stop_after_solutions, &stop);
+  dlx_checkpoint_set (stop.context, checkpoint, 100000);
+  assert (dlx_checkpoint_resume (stop.context, checkpoint));
+  assert (dlx_exact_cover_search (stop.context, 0) == 65);
+  assert (!dlx_search_interrupted (stop.context));
+  assert (stop.nb_solutions == 65);            // Solutions found before the checkpoint are not found again.
+  assert (dlx_solutions_total (stop.context) == 8 * 65);
+  dlx_search_context_destroy (stop.context);
+
+  stop.context = dlx_search_context_create (universe);
+  assert (!dlx_checkpoint_resume (stop.context, checkpoint));  // The checkpoint was saved with propagation.
+  dlx_propagation_set (stop.context, 1);
+  assert (dlx_checkpoint_resume (stop.context, checkpoint));   // The completed search is not run again.
+  assert (dlx_exact_cover_search (stop.context, 0) == 65);
+  dlx_search_context_destroy (stop.context);
+  remove (checkpoint);
+
+  // Distributed search: jobs fixing the first two levels, run by 4 worker processes.
+  stop.context = dlx_search_context_create (universe);
+  stop.nb_solutions = 0;
+  stop.stop_after = 0;
+  dlx_displayer_set (stop.context, stop_after_solutions, &stop);
+  assert (dlx_jobs_search (stop.context, 2, "pentomino", 4) == 65);
+  assert (!dlx_search_interrupted (stop.context));
+  assert (stop.nb_solutions == 65);            // Solutions are displayed by the coordinator.
+  assert (dlx_solutions_total (stop.context) == 8 * 65);
+
+  // The search is split in the order of subsets of the search context, not the one of a previous automatic choice.
+  dlx_displayer_set (stop.context, 0, 0);
+  dlx_engine_set (stop.context, DLX_ENGINE_AUTO);
+  dlx_subset_order_set (stop.context, DLX_ORDER_SHORTEST);
+  assert (dlx_exact_cover_search (stop.context, 1) == 1);
+  assert (dlx_jobs_search (stop.context, 2, "pentomino", 4) == 65 && dlx_solutions_total (stop.context) == 8 * 65);
+  dlx_search_context_destroy (stop.context);
+
+  // Progress reports, every 10000 nodes.
+  struct progress_data progress = { 0, 0 };
+
+  stop.context = dlx_search_context_create (universe);
+  dlx_displayer_set (stop.context, 0, 0);
+  dlx_progress_set (stop.context, check_progress, &progress, 10000, 0);
+  assert (dlx_exact_cover_search (stop.context, 0) == 65);
+  assert (progress.nb_reports == dlx_search_nodes (stop.context) / 10000);
+  dlx_search_context_destroy (stop.context);
+
+  // Solutions written to a binary solution sink (with a small buffer, written several times), then decoded.
+  const char *solutions = "pentomino.solutions";
+  SolutionSink sink = dlx_sink_create (solutions, 64);
+
+  stop.context = dlx_search_context_create (universe);
+  dlx_sink_set (stop.context, sink);
+  assert (dlx_exact_cover_search (stop.context, 0) == 65);
+  assert (dlx_sink_solutions (sink) == 65);
+  assert (dlx_jobs_search (stop.context, 2, "pentomino", 4) == 65);  // Solutions of jobs are written to the sink by the coordinator.
+  assert (dlx_sink_solutions (sink) == 2 * 65);
+  assert (dlx_sink_flush (sink));
+  dlx_sink_destroy (sink);
+  dlx_search_context_destroy (stop.context);
+
+  stop.nb_solutions = 0;
+  dlx_displayer_set (universe, stop_after_solutions, &stop);
+  assert (dlx_sink_decode (universe, solutions) == 2 * 65);
+  assert (stop.nb_solutions == 2 * 65);
+  remove (solutions);
 
   dlx_universe_destroy (universe);
 }
@@ -359,6 +573,11 @@ various_tests (void)
   dlx_subset_define (m, "Le", "E", ";");
   assert (dlx_exact_cover_search (m, 0) == 4);
   assert (dlx_exact_cover_search (m, 0) == 4);  // Can be rerun.
+  Universe c = dlx_universe_clone (m);
+  dlx_subset_define (c, "Lx", "A;B;C;D;E;F;G", ";");
+  assert (dlx_exact_cover_search (c, 0) == 5);  // The clone can be completed...
+  assert (dlx_exact_cover_search (m, 0) == 4);  // ... independently of the original universe.
+  dlx_universe_destroy (c);
   // Unset solution displayer.
   dlx_displayer_set (m, 0, 0);
   dlx_universe_destroy (m);
@@ -369,6 +588,47 @@ various_tests (void)
   dlx_subset_define (m, "", "B", ";");
   dlx_subset_define (m, "L", "A;B", ";");       // Another subset (with the same name, not recommended.)
   assert (dlx_exact_cover_search (m, 0) == 2);
+  assert (!dlx_duplicates_merge_set (m, 1));
+  dlx_subset_define (m, "L'", "A", ";");        // Identical to the first L: merged into it.
+  dlx_subset_define (m, "L''", "B;A", ";");     // Identical to the second L.
+  dlx_subset_define (m, "La", 2.0, "A", ";");   // Not merged: another weight.
+  assert (dlx_subset_multiplicity (m, 0) == 2 && dlx_subset_multiplicity (m, 2) == 2 && dlx_subset_multiplicity (m, 3) == 1);
+  assert (search_with_both_engines (m) == 3);
+  assert (dlx_exact_cover_search (m, 0) == 3);
+  assert (dlx_solutions_total (m) == 2 + 2 + 1);
+  // Merged subsets are found by their own names.
+  assert (dlx_subset_require_in_solution (m, "L''") && dlx_exact_cover_search (m, 0) == 1);
+  assert (dlx_subset_unrequire_in_solution (m, "L''") && dlx_exact_cover_search (m, 0) == 3);
+  // A merged subset is released by the name it was required by only.
+  assert (dlx_subset_require_in_solution (m, "L") && !dlx_subset_unrequire_in_solution (m, "L'"));
+  assert (dlx_subset_unrequire_in_solution (m, "L") && dlx_exact_cover_search (m, 0) == 3);
+  // A merged subset is disabled on its own: the identical subset is kept, with a lower multiplicity.
+  assert (dlx_subset_disable (m, "L'") && !dlx_subset_disable (m, "L'") && dlx_subset_multiplicity (m, 0) == 1);
+  assert (dlx_exact_cover_search (m, 0) == 3 && dlx_solutions_total (m) == 1 + 2 + 1);
+  assert (!dlx_subset_require_in_solution (m, "L'") && dlx_assumption_conflict (m)->reason == DLX_CONFLICT_DISABLED_SUBSET);
+  assert (dlx_subset_enable (m, "L'") && dlx_subset_multiplicity (m, 0) == 2 && dlx_exact_cover_search (m, 0) == 3 && dlx_solutions_total (m) == 5);
+  // A merged subset has no priority of its own.
+  assert (!dlx_subset_priority_set (m, "L''", 1) && dlx_subset_priority_set (m, "L", 1));
+  // Indices of subsets from names which are not passed by the library.
+  char copy[] = "La";
+
+  assert (dlx_subset_index (m, copy) == 3 && dlx_subset_index (m, "L''") == 2 && dlx_subset_index (m, "X") == ULONG_MAX);
+  dlx_universe_destroy (m);
+  // Many more merged subsets than distinct subsets defined after them.
+  m = dlx_universe_create ("0 1 2 3 4 5 6 7", " ");
+  dlx_trace_set (m, 0);
+  dlx_duplicates_merge_set (m, 1);
+  for (int i = 0; i < 200; i++)
+    dlx_subset_define (m, "", "0", " ");
+  for (int i = 0; i < 8; i++)
+    for (int j = i; j < 8; j++)
+    {
+      char pair[4] = { (char) ('0' + i), ' ', (char) ('0' + j), 0 };
+
+      dlx_subset_define (m, "", i == j ? pair + 2 : pair, " ");
+    }
+  assert (dlx_subset_multiplicity (m, 0) == 201);
+  assert (dlx_exact_cover_search (m, 0) == 764 && dlx_solutions_total (m) == 764 + 232 * 200);
   dlx_universe_destroy (m);
   //Test 4
   m = dlx_universe_create ("A;B", ";");
@@ -418,17 +678,323 @@ various_tests (void)
   dlx_subset_define (m, "Lb", "B", ";");
   assert (dlx_exact_cover_search (m, 0) == 2);
   dlx_universe_destroy (m);
+  //Test 9
+  m = dlx_universe_create ("A;B;C", ";");
+  dlx_subset_define (m, "Lab", "A;B", ";");
+  dlx_subset_define (m, "Lc", "C", ";");
+  dlx_subset_define (m, "La", "A", ";");
+  dlx_subset_define (m, "Lbc", "B;C", ";");
+  assert (dlx_exact_cover_search (m, 0) == 2);
+  assert (dlx_solutions_total (m) == 2);
+  const char *ab[] = { "A", "B" };
+  const char *ba[] = { "B", "A" };
+  assert (!dlx_symmetry_define (m, 2, ab, ba)); // Not a symmetry: La would be mapped on B.
+  const char *ac[] = { "A", "C" };
+  const char *ca[] = { "C", "A" };
+  assert (dlx_symmetry_define (m, 2, ac, ca));
+  assert (dlx_exact_cover_search (m, 0) == 1);  // {Lab, Lc} and {La, Lbc} are symmetric.
+  assert (dlx_solutions_total (m) == 2);
+  assert (dlx_subset_disable (m, "Lc"));
+  assert (dlx_exact_cover_search (m, 0) == 1);  // La is no longer mapped on an enabled subset.
+  assert (dlx_solutions_total (m) == 1);
+  dlx_universe_destroy (m);
+  // The symmetric group of 8 elements (40320 permutations) is too large: the symmetries are ignored.
+  m = dlx_universe_create ("0 1 2 3 4 5 6 7", " ");
+  dlx_trace_set (m, 0);
+  for (int i = 0; i < 8; i++)
+    for (int j = i; j < 8; j++)
+    {
+      char pair[4] = { (char) ('0' + i), ' ', (char) ('0' + j), 0 };
+
+      dlx_subset_define (m, "", i == j ? pair + 2 : pair, " ");
+    }
+  const unsigned long swap[] = { 1, 0, 2, 3, 4, 5, 6, 7 };
+  const unsigned long cycle[] = { 1, 2, 3, 4, 5, 6, 7, 0 };
+
+  assert (dlx_symmetry_define (m, 8, swap) && dlx_symmetry_define (m, 8, cycle));
+  assert (dlx_exact_cover_search (m, 0) == 764 && dlx_solutions_total (m) == 764);
+  dlx_universe_destroy (m);
+  //Test 10
+  m = dlx_universe_create ("A;B;C;D;E;F;G", ";");
+  dlx_subset_define (m, "L1", "C;E;F", ";");
+  dlx_subset_define (m, "L2", "A;D;G", ";");
+  dlx_subset_define (m, "L3", "B;C;F", ";");
+  dlx_subset_define (m, "L4", "A;D", ";");
+  dlx_subset_define (m, "L5", "B;G", ";");
+  dlx_subset_define (m, "L6", "D;E;G", ";");
+  dlx_subset_define (m, "L7", "A;B;C;D;E;F", ";");
+  dlx_subset_define (m, "Lg", "G", ";");
+  dlx_subset_define (m, "Le", "E", ";");
+  assert (dlx_subset_disable (m, "L7"));
+  assert (!dlx_subset_disable (m, "L7"));      // Already disabled.
+  assert (search_with_both_engines (m) == 3);
+  assert (dlx_subset_enable (m, "L7"));
+  assert (search_with_both_engines (m) == 4);
+  assert (dlx_subset_disable (m, "L4") && dlx_subset_disable (m, "L2"));
+  assert (search_with_both_engines (m) == 1);
+  assert (dlx_subset_enable (m, "L4") && dlx_subset_enable (m, "L2")); // Enabled in any order.
+  assert (search_with_both_engines (m) == 4);
+  assert (dlx_element_disable (m, "G"));
+  assert (search_with_both_engines (m) == 4);  // G is covered at most once, and Lg is no longer used.
+  assert (dlx_element_disable (m, "E"));
+  assert (search_with_both_engines (m) == 4);
+  assert (dlx_element_enable (m, "E"));
+  assert (dlx_subset_disable (m, "Lg"));
+  assert (search_with_both_engines (m) == 4);
+  assert (dlx_subset_enable (m, "Lg") && dlx_element_enable (m, "G"));
+  assert (!dlx_element_enable (m, "G"));       // Already enabled.
+  assert (dlx_subset_require_in_solution (m, "L1"));
+  assert (!dlx_subset_disable (m, "L1"));      // Required.
+  assert (search_with_both_engines (m) == 1);
+  assert (dlx_subset_disable (m, "L5"));
+  assert (search_with_both_engines (m) == 0);
+  assert (dlx_subset_enable (m, "L5"));
+  // Only the last subset required in solutions can be released.
+  assert (dlx_subset_require_in_solution (m, "L5") && !dlx_subset_unrequire_in_solution (m, "L1"));
+  assert (dlx_subset_unrequire_in_solution (m, "L5") && search_with_both_engines (m) == 1);
+  assert (dlx_subset_unrequire_in_solution (m, "L1"));
+  assert (!dlx_subset_unrequire_in_solution (m, "L1"));
+  assert (search_with_both_engines (m) == 4);
+  assert (dlx_assumption_push (m) == 1);
+  assert (dlx_subset_require_in_solution (m, "L1"));
+  assert (dlx_assumption_conflict (m)->reason == DLX_CONFLICT_NONE);
+  assert (search_with_both_engines (m) == 1);
+  assert (dlx_assumption_push (m) == 2);
+  assert (!dlx_subset_require_in_solution (m, "L3"));
+  assert (dlx_assumption_conflict (m)->reason == DLX_CONFLICT_ELEMENT_COVERED);
+  assert (!strcmp (dlx_assumption_conflict (m)->element, "C") && !strcmp (dlx_assumption_conflict (m)->required, "L1"));
+  assert (!dlx_subset_require_in_solution (m, "Lx"));
+  assert (dlx_assumption_conflict (m)->reason == DLX_CONFLICT_UNKNOWN_SUBSET);
+  assert (dlx_subset_disable (m, "L7"));
+  assert (!dlx_subset_require_in_solution (m, "L7"));
+  assert (dlx_assumption_conflict (m)->reason == DLX_CONFLICT_DISABLED_SUBSET);
+  assert (dlx_subset_enable (m, "L7"));
+  assert (dlx_subset_require_in_solution (m, "L5"));
+  assert (search_with_both_engines (m) == 1);
+  // Subsets and elements are disabled and enabled, by index, while subsets are required in solutions.
+  assert (dlx_subset_disable (m, dlx_subset_index (m, "L6")) && dlx_subset_disable (m, dlx_subset_index (m, "L4")));
+  assert (!dlx_subset_disable (m, dlx_subset_index (m, "L5")) && !dlx_subset_disable (m, 99UL));
+  assert (dlx_element_disable (m, 6UL) && !dlx_element_disable (m, 7UL));  // G, covered by L5.
+  assert (search_with_both_engines (m) == 0);
+  assert (dlx_assumption_pop (m));
+  assert (search_with_both_engines (m) == 0);  // L1 is still required.
+  assert (dlx_assumption_pop (m));
+  assert (search_with_both_engines (m) == 2);
+  assert (dlx_subset_enable (m, dlx_subset_index (m, "L4")) && dlx_element_enable (m, 6UL));
+  assert (search_with_both_engines (m) == 4);
+  assert (dlx_subset_enable (m, dlx_subset_index (m, "L6")));
+  assert (!dlx_assumption_pop (m));
+  assert (search_with_both_engines (m) == 4);  // Back to the base model.
+  dlx_universe_destroy (m);
+  //Test 11
+  m = dlx_universe_create ("H1;H2;H3;H4", ";");
+  dlx_subset_define (m, "S1", 3.0, "H1;H2", ";");
+  dlx_subset_define (m, "S2", 3.0, "H3;H4", ";");
+  dlx_subset_define (m, "S3", 7.0, "H1;H2;H3;H4", ";");
+  dlx_subset_define (m, "S4", 1.0, "H2;H3", ";");
+  dlx_subset_define (m, "S5", 1.0, "H1", ";");
+  assert (!dlx_subset_define (m, "S6", -1.0, "H4", ";"));  // Weights can not be negative.
+  dlx_subset_define (m, "S6", "H4", ";");                  // Weighs 1.
+  assert (dlx_exact_cover_search (m, 0) == 3);
+  assert (dlx_exact_cover_optimize (m) == 1);
+  assert (dlx_solution_cost (m) == 3);                      // {S5, S4, S6}
+  assert (dlx_exact_cover_search_shortest (m, 0) == 1);    // {S3}
+  assert (dlx_solution_length_max_set (m, 2) == 0);
+  assert (dlx_exact_cover_search (m, 0) == 2);              // {S1, S2} and {S3}
+  dlx_subset_disable (m, "S3");
+  assert (dlx_exact_cover_search_shortest (m, 0) == 1);    // {S1, S2}
+  dlx_solution_length_max_set (m, 1);
+  assert (dlx_exact_cover_search_shortest (m, 0) == 0);
+  dlx_subset_enable (m, "S3");
+  assert (dlx_solution_length_max_set (m, 0) == 1);
+  // Subsets forced by propagation count in the length of solutions.
+  Universe forced = dlx_universe_create ("A B C", " ");
+
+  dlx_subset_define (forced, "a", "A", " ");
+  dlx_subset_define (forced, "b", "B", " ");
+  dlx_subset_define (forced, "c", "C", " ");
+  dlx_subset_define (forced, "abc", "A B C", " ");
+  dlx_propagation_set (forced, 1);
+  assert (dlx_exact_cover_search (forced, 0) == 2);
+  dlx_solution_length_max_set (forced, 2);
+  assert (dlx_exact_cover_search (forced, 0) == 1);           // {abc}
+  dlx_solution_length_max_set (forced, 0);
+  assert (dlx_exact_cover_search_shortest (forced, 0) == 1);  // {abc}
+  dlx_universe_destroy (forced);
+  unsigned long nb_bytes = 0;
+  SolutionSink sink = dlx_sink_create (count_bytes, &nb_bytes, 0);
+
+  dlx_sink_set (m, sink);
+  assert (dlx_exact_cover_search (m, 0) == 3);
+  assert (dlx_sink_flush (sink));
+  assert (nb_bytes == 3 * 2 + 6);                           // Two counts per solution and 6 indices of subsets, one byte each.
+  dlx_sink_set (m, 0);
+  dlx_sink_destroy (sink);
+
+  assert (!dlx_auto_choice (m));
+  dlx_engine_set (m, DLX_ENGINE_AUTO);
+  assert (dlx_exact_cover_search (m, 0) == 3);
+  assert (dlx_auto_choice (m)->nb_subsets == 6 && dlx_auto_choice (m)->nb_cells == 12 && dlx_auto_choice (m)->nb_workers == 1);
+  dlx_engine_set (m, DLX_ENGINE_LINKS);
+
+  // Events of the search: subsets pushed and popped, and solutions.
+  struct event_data events = { { 0 }, 0, 0, { 0 } };
+  SearchContext context = dlx_search_context_create (m);
+
+  dlx_events_set (context, check_events, &events);
+  assert (dlx_exact_cover_search (context, 0) == 3);
+  assert (events.nb_solutions == 3 && events.depth == 0);
+  assert (events.frequency[0] == 1 && events.frequency[2] == 1 && events.frequency[3] == 1);    // S1, S3 and S4 in one solution each.
+  dlx_propagation_set (context, 1);
+  assert (dlx_exact_cover_search (context, 0) == 3);        // Forced subsets are pushed as well.
+  assert (events.nb_solutions == 6 && events.depth == 0);
+  dlx_search_context_destroy (context);
+  dlx_subset_require_in_solution (m, "S2");
+  assert (dlx_exact_cover_optimize (m) == 1);
+  assert (dlx_solution_cost (m) == 6);                      // {S2, S1}
+  dlx_subset_disable (m, "S1");
+  assert (dlx_exact_cover_optimize (m) == 0);
+  dlx_universe_destroy (m);
+  //Test 12
+  unsigned long queens[8];
+
+  m = dlx_queens_create (8);
+  dlx_displayer_set (m, check_queens, queens);
+  assert (search_with_both_engines (m) == 92);
+  dlx_universe_destroy (m);
+  m = dlx_queens_create (3);
+  assert (dlx_exact_cover_search (m, 0) == 0);
+  dlx_universe_destroy (m);
+  // A 2×2×2 cube, split in two halves along any of the three axes.
+  const struct dlx_cell cube[] = { {0, 0, 0}, {0, 0, 1}, {0, 1, 0}, {0, 1, 1}, {1, 0, 0}, {1, 0, 1}, {1, 1, 0}, {1, 1, 1} };
+  const struct dlx_cell square[] = { {0, 0, 0}, {0, 1, 0}, {1, 0, 0}, {1, 1, 0} };
+  const struct dlx_piece halves[] = { {"A", 4, square}, {"B", 4, square} };
+
+  m = dlx_polyomino_create (8, cube, 2, halves, 3, 0);
+  assert (dlx_exact_cover_search (m, 0) == 3 * 2);
+  dlx_universe_destroy (m);
+  m = dlx_polyomino_create (8, cube, 2, halves, 2, 0);
+  assert (dlx_exact_cover_search (m, 0) == 2);              // Squares are not rotated out of the plane (x, y).
+  dlx_universe_destroy (m);
+  // Cells of the board far apart, and a repeated cell.
+  const struct dlx_cell far[] = { {0, 0, 0}, {1000000000, -1000000000, 0}, {0, 0, 0} };
+  const struct dlx_piece monominoes[] = { {"A", 1, square}, {"B", 1, square} };
+
+  m = dlx_polyomino_create (2, far, 2, monominoes, 2, 0);
+  assert (dlx_exact_cover_search (m, 0) == 2);
+  dlx_universe_destroy (m);
+  assert (!dlx_polyomino_create (3, far, 2, monominoes, 2, 0));
+
+  //Test 13
+  // The 4 solutions of the 6-queens problem (told apart by their first queen) are drawn about as often as each other,
+  // exactly uniformly if the search tree is counted, approximately by probes otherwise.
+  unsigned long first_queens[6];
+
+  m = dlx_queens_create (6);
+  dlx_displayer_set (m, count_first_queens, first_queens);
+  SearchContext sampler = dlx_search_context_create (m);
+
+  dlx_trace_set (sampler, 0);
+  for (int exact = 1; exact >= 0; exact--)
+  {
+    memset (first_queens, 0, sizeof (first_queens));
+    dlx_sampling_set (sampler, 64, exact ? 10000 : 0, 7);
+    assert (dlx_exact_cover_sample (sampler, 4000) == 4000);
+    assert (dlx_sampling_quality (sampler)->exact == exact);
+    assert (dlx_sampling_quality (sampler)->estimated_solutions > 3.5 && dlx_sampling_quality (sampler)->estimated_solutions < 4.5);
+    for (unsigned long i = 0; i < 6; i++)
+      assert (i == 0 || i == 5 ? !first_queens[i] : first_queens[i] > 800 && first_queens[i] < 1200);
+  }
+  dlx_search_context_destroy (sampler);
+  dlx_universe_destroy (m);
+
+  //Test 14
+  // Orders of subsets change the first solution found, not the search of all solutions.
+  const char *first_subset = 0;
+
+  m = dlx_universe_create ("A B", " ");
+  dlx_subset_define (m, "s1", "A", " ");
+  dlx_subset_define (m, "s2", "B", " ");
+  dlx_subset_define (m, "s3", "A B", " ");
+  dlx_displayer_set (m, keep_first_subset, &first_subset);
+  assert (dlx_exact_cover_search (m, 1) == 1 && !strcmp (first_subset, "s1"));
+  dlx_subset_order_set (m, DLX_ORDER_LONGEST);
+  assert (dlx_exact_cover_search (m, 1) == 1 && !strcmp (first_subset, "s3"));
+  dlx_subset_order_set (m, DLX_ORDER_PRIORITY);
+  assert (dlx_subset_priority_set (m, "s1", 2) && dlx_exact_cover_search (m, 1) == 1 && !strcmp (first_subset, "s1"));
+  dlx_universe_destroy (m);
+
+  m = dlx_queens_create (8);
+  dlx_trace_set (m, 0);
+  SearchContext ordered = dlx_search_context_create (m);
+
+  for (enum dlx_subset_order order = DLX_ORDER_DEFINITION; order <= DLX_ORDER_FAILURES; order++)
+  {
+    dlx_subset_order_set (ordered, order);
+    assert (dlx_exact_cover_search (ordered, 0) == 92 && dlx_search_nodes (ordered) == 1199);
+  }
+  // Subsets which failed the most during the previous searches are tried last.
+  dlx_subset_order_set (ordered, DLX_ORDER_DEFINITION);
+  assert (dlx_exact_cover_search (ordered, 1) == 1);
+  unsigned long nodes = dlx_search_nodes (ordered);
+
+  dlx_subset_order_set (ordered, DLX_ORDER_FAILURES);
+  assert (dlx_exact_cover_search (ordered, 1) == 1 && dlx_search_nodes (ordered) < nodes);
+  // Checkpoints are resumed with the order they were saved with only, and never in order of failures.
+  dlx_checkpoint_set (ordered, "queens.checkpoint", 0);
+  assert (dlx_exact_cover_search (ordered, 1) == 1 && dlx_search_nodes (ordered) == nodes);
+  dlx_subset_order_set (ordered, DLX_ORDER_LONGEST);
+  assert (!dlx_checkpoint_resume (ordered, "queens.checkpoint"));
+  dlx_subset_order_set (ordered, DLX_ORDER_DEFINITION);
+  assert (dlx_checkpoint_resume (ordered, "queens.checkpoint"));
+  dlx_checkpoint_set (ordered, 0, 0);
+  remove ("queens.checkpoint");
+  dlx_search_context_destroy (ordered);
+
+  //Test 15
+  // Memory policies change where the links are, not the search. Policies not supported by the system are cleared.
+  dlx_memory_policy_set (m, DLX_MEMORY_HUGE_PAGES | DLX_MEMORY_LOCAL);
+  SearchContext mapped = dlx_search_context_create (m);
+
+  assert (dlx_exact_cover_search (mapped, 0) == 92 && dlx_search_nodes (mapped) == 1199);
+  const struct dlx_memory_statistics *memory = dlx_memory_statistics (mapped);
+
+  assert (memory->bytes > 0);
+  assert (!(memory->policy & ~(DLX_MEMORY_HUGE_PAGES | DLX_MEMORY_LOCAL)));
+  assert (memory->huge_page_bytes <= memory->bytes);
+  assert (dlx_memory_statistics (mapped) == memory);
+  dlx_search_context_destroy (mapped);
+
+  //Test 16
+  // Nogoods prune the subproblems already found to have no solution, without changing the solutions found.
+  SearchContext learning = dlx_search_context_create (m);
+
+  assert (dlx_nogoods_set (learning, 1 << 12) == 0 && dlx_nogood_statistics (learning)->capacity >= 1 << 12);
+  assert (dlx_exact_cover_search (learning, 0) == 92 && dlx_search_nodes (learning) <= 1199 && dlx_nogood_statistics (learning)->recorded > 0);
+  // Nogoods are kept between searches.
+  assert (dlx_exact_cover_search (learning, 0) == 92 && dlx_search_nodes (learning) < 1199 && dlx_nogood_statistics (learning)->hits > 0);
+  assert (dlx_exact_cover_search (learning, 1) == 1);
+  // A full store replaces older nogoods.
+  assert (dlx_nogoods_set (learning, 16) >= 1 << 12 && dlx_nogood_statistics (learning)->stored == 0);
+  assert (dlx_exact_cover_search (learning, 0) == 92 && dlx_nogood_statistics (learning)->replaced > 0);
+  assert (dlx_nogood_statistics (learning)->stored <= dlx_nogood_statistics (learning)->capacity);
+  // The hash of the covered elements follows the subsets forced by propagation.
+  dlx_propagation_set (learning, 1);
+  assert (dlx_nogoods_set (learning, 1 << 12) && dlx_exact_cover_search (learning, 0) == 92 && dlx_exact_cover_search (learning, 0) == 92);
+  assert (dlx_nogood_statistics (learning)->hits > 0);
+  dlx_search_context_destroy (learning);
+  dlx_universe_destroy (m);
 }
 
 int
 main (void)
 {
-  dlx_trace = 1;
+  setenv ("DLX_TRACE", "1", 1);   // Universes trace their execution.
   printf ("======= UNIT TESTS =======\n");
   various_tests ();
   printf ("======= SUDOKU SOLVER =======\n");
   test_sudoku ();
-  dlx_trace = 0;
+  unsetenv ("DLX_TRACE");
   printf ("======= PENTOMINO =======\n");
   test_pentomino ();
 }